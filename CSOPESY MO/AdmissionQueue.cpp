@@ -0,0 +1,91 @@
+#include "AdmissionQueue.h"
+#include <algorithm>
+#include <cctype>
+
+bool AdmissionQueue::setPolicy(const std::string& policyName) {
+    std::string key = policyName;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+    if (key == "fifo") policy = Policy::FIFO;
+    else if (key == "first-fit") policy = Policy::FIRST_FIT;
+    else if (key == "smallest-first") policy = Policy::SMALLEST_FIRST;
+    else return false;
+    return true;
+}
+
+const char* AdmissionQueue::getPolicyName() const {
+    switch (policy) {
+    case Policy::FIRST_FIT: return "FIRST-FIT";
+    case Policy::SMALLEST_FIRST: return "SMALLEST-FIRST";
+    default: return "FIFO";
+    }
+}
+
+void AdmissionQueue::push(std::shared_ptr<Screen> process, size_t memorySize) {
+    waiting.push_back({ std::move(process), memorySize, std::chrono::steady_clock::now() });
+    length.store(waiting.size(), std::memory_order_relaxed);
+}
+
+std::vector<std::shared_ptr<Screen>> AdmissionQueue::admit(const std::function<bool(const PendingAdmission&)>& tryAdmit) {
+    std::vector<std::shared_ptr<Screen>> admitted;
+
+    // Only the head can be admitted, so the rest of the queue is never scanned
+    if (policy == Policy::FIFO) {
+        while (!waiting.empty() && tryAdmit(waiting.front())) {
+            recordAdmission(waiting.front());
+            admitted.push_back(std::move(waiting.front().process));
+            waiting.pop_front();
+        }
+        length.store(waiting.size(), std::memory_order_relaxed);
+        return admitted;
+    }
+
+    // Order in which waiting entries are offered
+    std::vector<size_t> order(waiting.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    if (policy == Policy::SMALLEST_FIRST) {
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return waiting[a].memorySize < waiting[b].memorySize;
+        });
+    }
+
+    std::vector<bool> taken(waiting.size(), false);
+    for (size_t index : order) {
+        if (tryAdmit(waiting[index])) {
+            taken[index] = true;
+            recordAdmission(waiting[index]);
+            admitted.push_back(waiting[index].process);
+        } else if (policy == Policy::SMALLEST_FIRST) {
+            break;
+        }
+    }
+
+    // Drop admitted entries, keeping the rest in arrival order
+    if (!admitted.empty()) {
+        std::deque<PendingAdmission> remaining;
+        for (size_t i = 0; i < waiting.size(); i++) {
+            if (!taken[i]) {
+                remaining.push_back(std::move(waiting[i]));
+            }
+        }
+        waiting.swap(remaining);
+        length.store(waiting.size(), std::memory_order_relaxed);
+    }
+    return admitted;
+}
+
+double AdmissionQueue::getAverageLatencyMs() const {
+    size_t count = admittedCount.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(totalLatencyMicros.load(std::memory_order_relaxed)) / 1000.0 / count;
+}
+
+void AdmissionQueue::recordAdmission(const PendingAdmission& entry) {
+    auto waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entry.enqueuedAt);
+    totalLatencyMicros.fetch_add(static_cast<size_t>(waited.count()), std::memory_order_relaxed);
+    admittedCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ADMISSION_QUEUE_H
+#define ADMISSION_QUEUE_H
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+class Screen;
+
+// A process waiting for memory, with the size it asked for
+struct PendingAdmission {
+    std::shared_ptr<Screen> process;
+    size_t memorySize;
+    std::chrono::steady_clock::time_point enqueuedAt;
+};
+
+// Processes that arrived while memory was fully committed, admitted as memory
+// is released. The policy only decides the order candidates are tried in:
+//   fifo           - arrival order; a process that does not fit blocks the rest
+//   first-fit      - arrival order, skipping processes that do not fit yet
+//   smallest-first - smallest request first; stops at the first that does not fit
+// Not thread-safe: MemoryManager serializes every call except the statistics.
+class AdmissionQueue {
+public:
+    // False if the name is unknown (the policy is left unchanged)
+    bool setPolicy(const std::string& policyName);
+    const char* getPolicyName() const;
+
+    void push(std::shared_ptr<Screen> process, size_t memorySize);
+
+    // Offer waiting processes to tryAdmit in policy order. tryAdmit allocates the
+    // memory and returns false if the process does not fit. Returns the admitted processes.
+    std::vector<std::shared_ptr<Screen>> admit(const std::function<bool(const PendingAdmission&)>& tryAdmit);
+
+    // Statistics, safe to read without the caller's lock
+    size_t getLength() const { return length.load(std::memory_order_relaxed); }
+    size_t getAdmittedCount() const { return admittedCount.load(std::memory_order_relaxed); }
+    double getAverageLatencyMs() const;
+
+private:
+    enum class Policy { FIFO, FIRST_FIT, SMALLEST_FIRST };
+
+    void recordAdmission(const PendingAdmission& entry);
+
+    Policy policy = Policy::FIFO;
+    std::deque<PendingAdmission> waiting;
+
+    std::atomic<size_t> length{ 0 };
+    std::atomic<size_t> admittedCount{ 0 };
+    std::atomic<size_t> totalLatencyMicros{ 0 };   // Time from push to admission, summed
+};
+
+#endif // ADMISSION_QUEUE_H
@@ -0,0 +1,373 @@
+#include "BackingStore.h"
+#include <algorithm>
+#include <iostream>
+
+BackingStore::BackingStore(const std::string& fileName, size_t pageSize)
+    : fileName(fileName), pageSize(pageSize), pool(pageSize / sizeof(uint16_t)) {
+    reset();
+}
+
+BackingStore::~BackingStore() {
+    stopWriter();
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+// Start from an empty file every time the memory manager is created
+void BackingStore::reset() {
+    pool.clear();
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        pending.clear();
+        order.clear();
+        queueCV.wait(lock, [this] { return writesInFlight == 0; });
+        queueCV.notify_all();
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (file.is_open()) {
+        file.close();
+    }
+
+    file.open(fileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "[ERROR] Failed to open backing store file " << fileName << std::endl;
+    }
+
+    nextSlot = 0;
+    freeSlots.clear();
+    slotReferences.clear();
+}
+
+// The lowest free slot, so the file stays as short as it can
+size_t BackingStore::allocateSlot() {
+    size_t slot;
+    if (!freeSlots.empty()) {
+        slot = *freeSlots.begin();
+        freeSlots.erase(freeSlots.begin());
+    } else {
+        slot = nextSlot++;
+        slotReferences.push_back(0);
+    }
+    slotReferences[slot] = 1;
+    return slot;
+}
+
+// Always consecutive slots, so a run written together can be read back together.
+// Takes the first run of count freed slots; failing that, a freed run reaching the
+// end of the file is extended, and only then does the run start at nextSlot.
+size_t BackingStore::allocateSlots(size_t count) {
+    if (count == 0) return nextSlot;
+
+    size_t runStart = nextSlot;
+    size_t runLength = 0;
+    for (size_t slot : freeSlots) {
+        if (runLength > 0 && slot == runStart + runLength) {
+            runLength++;
+        } else {
+            runStart = slot;
+            runLength = 1;
+        }
+        if (runLength == count) {
+            break;
+        }
+    }
+    if (runLength < count && runStart + runLength != nextSlot) {
+        runStart = nextSlot;
+    }
+
+    auto first = freeSlots.lower_bound(runStart);
+    auto last = freeSlots.lower_bound(runStart + count);
+    freeSlots.erase(first, last);
+    for (size_t slot = runStart; slot < std::min(runStart + count, nextSlot); slot++) {
+        slotReferences[slot] = 1;
+    }
+    if (runStart + count > nextSlot) {
+        nextSlot = runStart + count;
+        slotReferences.resize(nextSlot, 1);
+    }
+    return runStart;
+}
+
+void BackingStore::retainSlot(size_t slot) {
+    if (slot == NO_SLOT || slot >= nextSlot) return;
+    slotReferences[slot]++;
+}
+
+size_t BackingStore::getSlotReferences(size_t slot) const {
+    return slot < nextSlot ? slotReferences[slot] : 0;
+}
+
+// Dropping the last reference frees the slot. A pooled copy or queued write
+// for it is dropped as well; its data is no longer wanted.
+void BackingStore::releaseSlot(size_t slot) {
+    if (slot == NO_SLOT || slot >= nextSlot || slotReferences[slot] == 0) return;
+    if (--slotReferences[slot] > 0) return;
+    pool.erase(slot);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (pending.erase(slot) > 0) {
+            queueCV.notify_all();
+        }
+    }
+    freeSlots.insert(slot);
+}
+
+// Compress the page into the pool; whatever the pool pushes out, or a page that
+// does not compress, continues to the queue or file
+bool BackingStore::writePage(size_t slot, const uint16_t* data) {
+    if (slot == NO_SLOT) return false;
+
+    std::unique_lock<std::mutex> spillLock(spillMutex);
+    if (pool.isEnabled()) {
+        std::vector<std::pair<size_t, std::vector<uint16_t>>> spilled;
+        bool pooled = pool.store(slot, data, spilled);
+        bool ok = true;
+        for (const auto& page : spilled) {
+            ok = writeThrough(page.first, page.second.data()) && ok;
+        }
+        if (pooled) {
+            return ok;
+        }
+    }
+    spillLock.unlock();
+    return writeThrough(slot, data);
+}
+
+// Queue the page for the writer, waiting only while the queue is full.
+// A newer write to a slot that is still queued replaces the older data.
+bool BackingStore::writeThrough(size_t slot, const uint16_t* data) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (queueCapacity == 0) {
+        lock.unlock();
+        return writeToFile(slot, data);
+    }
+
+    queueCV.wait(lock, [this, slot] {
+        return pending.size() < queueCapacity || pending.count(slot) > 0;
+    });
+
+    PendingWrite& entry = pending[slot];
+    entry.data.assign(data, data + pageSize / sizeof(uint16_t));
+    entry.sequence = nextSequence++;
+    entry.queuedAt = std::chrono::steady_clock::now();
+    order.emplace_back(slot, entry.sequence);
+    queueCV.notify_all();
+    return true;
+}
+
+// A pooled page is the newest copy, then one still waiting in the queue, then the file
+bool BackingStore::readPage(size_t slot, uint16_t* data) {
+    if (slot == NO_SLOT) return false;
+
+    {
+        std::lock_guard<std::mutex> spillLock(spillMutex);
+        if (pool.isEnabled() && pool.load(slot, data)) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto it = pending.find(slot);
+        if (it != pending.end()) {
+            std::copy(it->second.data.begin(), it->second.data.end(), data);
+            queueReads.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (!file.is_open()) return false;
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(slot) * static_cast<std::streamoff>(pageSize));
+    file.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(pageSize));
+    fileReads.fetch_add(1, std::memory_order_relaxed);
+    return file.gcount() == static_cast<std::streamsize>(pageSize);
+}
+
+// A run holding a pooled or queued page is read page by page, so that page comes
+// from memory
+bool BackingStore::readPages(size_t firstSlot, size_t count, uint16_t* const* destinations) {
+    if (firstSlot == NO_SLOT || count == 0) return false;
+
+    bool anyQueued = false;
+    {
+        std::lock_guard<std::mutex> spillLock(spillMutex);
+        for (size_t i = 0; i < count && !anyQueued && pool.isEnabled(); i++) {
+            anyQueued = pool.contains(firstSlot + i);
+        }
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (size_t i = 0; i < count && !anyQueued; i++) {
+            anyQueued = pending.count(firstSlot + i) > 0;
+        }
+    }
+    if (anyQueued) {
+        bool ok = true;
+        for (size_t i = 0; i < count; i++) {
+            ok = readPage(firstSlot + i, destinations[i]) && ok;
+        }
+        return ok;
+    }
+
+    size_t wordsPerPage = pageSize / sizeof(uint16_t);
+    std::vector<uint16_t> buffer(count * wordsPerPage);
+    {
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        if (!file.is_open()) return false;
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(firstSlot) * static_cast<std::streamoff>(pageSize));
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(count * pageSize));
+        if (file.gcount() != static_cast<std::streamsize>(count * pageSize)) {
+            return false;
+        }
+    }
+    fileReads.fetch_add(count, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; i++) {
+        std::copy(buffer.begin() + i * wordsPerPage, buffer.begin() + (i + 1) * wordsPerPage, destinations[i]);
+    }
+    return true;
+}
+
+bool BackingStore::writePages(size_t firstSlot, size_t count, const uint16_t* const* sources) {
+    if (firstSlot == NO_SLOT || count == 0) return false;
+
+    size_t wordsPerPage = pageSize / sizeof(uint16_t);
+    std::vector<uint16_t> buffer(count * wordsPerPage);
+    for (size_t i = 0; i < count; i++) {
+        std::copy(sources[i], sources[i] + wordsPerPage, buffer.begin() + i * wordsPerPage);
+    }
+
+    // A reused slot may still have the write of its previous owner in flight, which
+    // must not land on top of this one
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueCV.wait(lock, [this, firstSlot, count] {
+            return writesInFlight == 0 || inFlightSlot < firstSlot || inFlightSlot >= firstSlot + count;
+        });
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (!file.is_open()) return false;
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(firstSlot) * static_cast<std::streamoff>(pageSize));
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(count * pageSize));
+    return file.good();
+}
+
+void BackingStore::setWriteQueueCapacity(size_t capacity) {
+    if (capacity == 0) {
+        flush();
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queueCapacity = capacity;
+    if (capacity > 0 && !writer.joinable()) {
+        stopping = false;
+        writer = std::thread(&BackingStore::writerLoop, this);
+    }
+    queueCV.notify_all();
+}
+
+// Shrinking the pool writes the pages that no longer fit through to the file
+void BackingStore::setCompressedPoolCapacity(size_t bytes) {
+    std::lock_guard<std::mutex> spillLock(spillMutex);
+    std::vector<std::pair<size_t, std::vector<uint16_t>>> spilled;
+    pool.setCapacity(bytes, spilled);
+    for (const auto& page : spilled) {
+        if (!writeThrough(page.first, page.second.data())) {
+            std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+        }
+    }
+}
+
+void BackingStore::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueCV.wait(lock, [this] { return pending.empty() && writesInFlight == 0; });
+}
+
+size_t BackingStore::getQueuedWrites() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pending.size();
+}
+
+double BackingStore::getWriterLagMs() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+
+    // The write in flight is older than anything left in the queue
+    bool found = writesInFlight > 0;
+    std::chrono::steady_clock::time_point oldest = inFlightQueuedAt;
+    if (!found) {
+        for (const auto& queued : order) {
+            auto it = pending.find(queued.first);
+            if (it != pending.end() && it->second.sequence == queued.second) {
+                oldest = it->second.queuedAt;
+                found = true;
+                break;
+            }
+        }
+    }
+    if (!found) {
+        return 0.0;
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - oldest).count();
+}
+
+// Persist queued pages in arrival order. The data stays in pending while it is
+// written, so a page-in racing with the writer still finds it.
+void BackingStore::writerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        queueCV.wait(lock, [this] { return stopping || !order.empty(); });
+        if (order.empty()) {
+            break;
+        }
+
+        std::pair<size_t, uint64_t> next = order.front();
+        order.pop_front();
+        auto it = pending.find(next.first);
+        if (it == pending.end() || it->second.sequence != next.second) {
+            continue;  // Overtaken by a newer write or the slot was released
+        }
+
+        std::vector<uint16_t> data = it->second.data;
+        inFlightQueuedAt = it->second.queuedAt;
+        inFlightSlot = next.first;
+        writesInFlight++;
+        lock.unlock();
+
+        if (!writeToFile(next.first, data.data())) {
+            std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+        }
+
+        lock.lock();
+        writesInFlight--;
+        inFlightSlot = NO_SLOT;
+        it = pending.find(next.first);
+        if (it != pending.end() && it->second.sequence == next.second) {
+            pending.erase(it);
+        }
+        queueCV.notify_all();
+    }
+}
+
+// Finishes every queued write before the thread exits
+void BackingStore::stopWriter() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCV.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+bool BackingStore::writeToFile(size_t slot, const uint16_t* data) {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (!file.is_open()) return false;
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(slot) * static_cast<std::streamoff>(pageSize));
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(pageSize));
+    return file.good();
+}
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef BACKING_STORE_H
+#define BACKING_STORE_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <set>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+
+#include "CompressedPool.h"
+
+// Binary backing store made of fixed-size page slots.
+// Slot N lives at byte offset N * pageSize, so a page-in or page-out is a
+// single seek plus one page-sized read or write regardless of how long the
+// system has been running. The caller keeps the (process, page) -> slot index.
+//
+// With a write queue capacity set, writePage copies the page into a bounded
+// queue and a background writer persists it, so evictions do not wait on the
+// file. A queued page stays readable: readPage serves it from the queue until
+// the writer has stored it. Slot management is not thread-safe (the caller
+// serializes it); page I/O may overlap with the writer thread.
+//
+// With a compressed pool capacity set, written pages are compressed into memory
+// first and only reach the write queue or file when the pool pushes them out,
+// oldest first. Reads look in the pool, then the queue, then the file.
+//
+// Slots are reference counted so pages shared copy-on-write can keep one copy:
+// allocateSlot hands out one reference, retainSlot adds one, and releaseSlot
+// frees the slot once the last reference is gone.
+class BackingStore {
+public:
+    static const size_t NO_SLOT = static_cast<size_t>(-1);
+
+    BackingStore(const std::string& fileName, size_t pageSize);
+    ~BackingStore();
+
+    // Drop queued writes, truncate the file and forget every slot
+    void reset();
+
+    // Slot management
+    size_t allocateSlot();
+    // count consecutive slots, one reference each; returns the first. Reuses a run of
+    // freed slots when one fits and only grows the file otherwise.
+    size_t allocateSlots(size_t count);
+    void retainSlot(size_t slot);
+    void releaseSlot(size_t slot);
+    size_t getSlotReferences(size_t slot) const;
+
+    // Positioned page I/O (pageSize bytes, i.e. pageSize / 2 uint16 values)
+    bool writePage(size_t slot, const uint16_t* data);
+    bool readPage(size_t slot, uint16_t* data);
+    // Read count consecutive slots starting at firstSlot with one seek and one read,
+    // scattering slot firstSlot + i into destinations[i]
+    bool readPages(size_t firstSlot, size_t count, uint16_t* const* destinations);
+    // Write sources[i] to slot firstSlot + i with one seek and one write, straight to
+    // the file. Meant for a run fresh from allocateSlots, which nothing else has queued.
+    bool writePages(size_t firstSlot, size_t count, const uint16_t* const* sources);
+
+    // Most page writes waiting for the writer; 0 writes synchronously
+    void setWriteQueueCapacity(size_t capacity);
+    // Block until every queued write has reached the file
+    void flush();
+    // Compressed bytes kept in memory ahead of the file; 0 sends every page to the file
+    void setCompressedPoolCapacity(size_t bytes);
+
+    const std::string& getFileName() const { return fileName; }
+    size_t getSlotsInUse() const { return nextSlot - freeSlots.size(); }
+
+    // Write-back metrics
+    size_t getQueuedWrites() const;
+    double getWriterLagMs() const;   // Age of the oldest write not yet persisted
+    size_t getQueueReads() const { return queueReads.load(std::memory_order_relaxed); }
+    size_t getFileReads() const { return fileReads.load(std::memory_order_relaxed); }
+    const CompressedPool& getCompressedPool() const { return pool; }
+
+private:
+    struct PendingWrite {
+        std::vector<uint16_t> data;
+        uint64_t sequence;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    void writerLoop();
+    void stopWriter();
+    bool writeThrough(size_t slot, const uint16_t* data);
+    bool writeToFile(size_t slot, const uint16_t* data);
+
+    std::string fileName;
+    size_t pageSize;
+    std::fstream file;
+    std::mutex fileMutex;            // Serializes the stream between callers and the writer
+
+    size_t nextSlot = 0;             // First slot never handed out
+    std::set<size_t> freeSlots;      // Released slots available for reuse, ordered so runs of them show up
+    std::vector<uint32_t> slotReferences;  // Pages referencing each slot, 0 while free
+
+    // Write queue. pending holds the newest unpersisted data per slot; order holds
+    // (slot, sequence) in arrival order, and entries overtaken by a newer write or
+    // a released slot are skipped by the writer.
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCV;
+    std::unordered_map<size_t, PendingWrite> pending;
+    std::deque<std::pair<size_t, uint64_t>> order;
+    size_t queueCapacity = 0;
+    size_t writesInFlight = 0;       // Taken off the queue, not yet in the file
+    size_t inFlightSlot = NO_SLOT;   // Slot of that write
+    std::chrono::steady_clock::time_point inFlightQueuedAt;
+    uint64_t nextSequence = 1;
+    bool stopping = false;
+    std::thread writer;
+
+    std::atomic<size_t> queueReads{ 0 };   // Page-ins served from the write queue
+    std::atomic<size_t> fileReads{ 0 };    // Page-ins read from the file
+
+    CompressedPool pool;
+    // Held from a pool store until its spilled pages are queued or written, and by
+    // readers while they look in the pool and queue, so a spilled page is always
+    // found in one of the three places
+    std::mutex spillMutex;
+};
+
+#endif // BACKING_STORE_H
@@ -0,0 +1,180 @@
+#include "CompressedPool.h"
+#include <algorithm>
+
+namespace {
+    const size_t MAX_RUN = 128;
+}
+
+CompressedPool::CompressedPool(size_t pageWords) : pageWords(pageWords) {}
+
+void CompressedPool::setCapacity(size_t bytes, std::vector<std::pair<size_t, std::vector<uint16_t>>>& spilled) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity.store(bytes, std::memory_order_relaxed);
+
+    // Whatever no longer fits is handed back for the file, oldest first
+    while (!entries.empty() && storedBytes.load(std::memory_order_relaxed) > bytes) {
+        std::pair<size_t, uint64_t> oldest = order.front();
+        order.pop_front();
+        if (!isLive(oldest)) {
+            continue;
+        }
+        auto it = entries.find(oldest.first);
+        spilled.emplace_back(oldest.first, std::vector<uint16_t>(pageWords));
+        decompress(it->second.data, spilled.back().second.data());
+        removeLocked(it);
+        spills.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool CompressedPool::store(size_t slot, const uint16_t* data, std::vector<std::pair<size_t, std::vector<uint16_t>>>& spilled) {
+    std::vector<uint8_t> compressed;
+    compress(data, compressed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto existing = entries.find(slot);
+    if (existing != entries.end()) {
+        removeLocked(existing);
+    }
+
+    size_t limit = capacity.load(std::memory_order_relaxed);
+    if (compressed.size() >= pageWords * sizeof(uint16_t) || compressed.size() > limit) {
+        rejects.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Entry& entry = entries[slot];
+    entry.sequence = nextSequence++;
+    storedBytes.fetch_add(compressed.size(), std::memory_order_relaxed);
+    storedPages.fetch_add(1, std::memory_order_relaxed);
+    entry.data = std::move(compressed);
+    order.emplace_back(slot, entry.sequence);
+
+    // Make room by pushing the oldest pages out; the new page is the newest, so it stays
+    while (storedBytes.load(std::memory_order_relaxed) > limit) {
+        std::pair<size_t, uint64_t> oldest = order.front();
+        order.pop_front();
+        if (!isLive(oldest)) {
+            continue;  // Replaced or erased since it was stored
+        }
+        auto it = entries.find(oldest.first);
+        spilled.emplace_back(oldest.first, std::vector<uint16_t>(pageWords));
+        decompress(it->second.data, spilled.back().second.data());
+        removeLocked(it);
+        spills.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool CompressedPool::load(size_t slot, uint16_t* data) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(slot);
+    if (it == entries.end() || !decompress(it->second.data, data)) {
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CompressedPool::contains(size_t slot) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.count(slot) > 0;
+}
+
+void CompressedPool::erase(size_t slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(slot);
+    if (it != entries.end()) {
+        removeLocked(it);
+    }
+}
+
+void CompressedPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    order.clear();
+    storedPages.store(0, std::memory_order_relaxed);
+    storedBytes.store(0, std::memory_order_relaxed);
+}
+
+double CompressedPool::getCompressionRatio() const {
+    size_t bytes = getStoredBytes();
+    if (bytes == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(getStoredPages() * pageWords * sizeof(uint16_t)) / bytes;
+}
+
+void CompressedPool::removeLocked(std::unordered_map<size_t, Entry>::iterator it) {
+    storedBytes.fetch_sub(it->second.data.size(), std::memory_order_relaxed);
+    storedPages.fetch_sub(1, std::memory_order_relaxed);
+    entries.erase(it);
+
+    if (order.size() > 2 * entries.size()) {
+        order.erase(std::remove_if(order.begin(), order.end(),
+            [this](const std::pair<size_t, uint64_t>& position) { return !isLive(position); }),
+            order.end());
+    }
+}
+
+bool CompressedPool::isLive(const std::pair<size_t, uint64_t>& position) const {
+    auto it = entries.find(position.first);
+    return it != entries.end() && it->second.sequence == position.second;
+}
+
+void CompressedPool::compress(const uint16_t* words, std::vector<uint8_t>& out) const {
+    size_t i = 0;
+    while (i < pageWords) {
+        size_t run = 0;
+        if (words[i] == 0) {
+            while (i + run < pageWords && run < MAX_RUN && words[i + run] == 0) {
+                run++;
+            }
+            out.push_back(static_cast<uint8_t>(run - 1));
+        } else {
+            while (i + run < pageWords && run < MAX_RUN && words[i + run] != 0) {
+                run++;
+            }
+            out.push_back(static_cast<uint8_t>(0x80 | (run - 1)));
+            for (size_t j = i; j < i + run; j++) {
+                uint32_t value = words[j];
+                while (value >= 0x80) {
+                    out.push_back(static_cast<uint8_t>(0x80 | (value & 0x7F)));
+                    value >>= 7;
+                }
+                out.push_back(static_cast<uint8_t>(value));
+            }
+        }
+        i += run;
+    }
+}
+
+bool CompressedPool::decompress(const std::vector<uint8_t>& in, uint16_t* words) const {
+    size_t pos = 0;
+    size_t i = 0;
+    while (pos < in.size() && i < pageWords) {
+        uint8_t token = in[pos++];
+        size_t run = (token & 0x7F) + 1;
+        if (i + run > pageWords) {
+            return false;
+        }
+        if ((token & 0x80) == 0) {
+            std::fill(words + i, words + i + run, static_cast<uint16_t>(0));
+            i += run;
+            continue;
+        }
+        for (size_t j = 0; j < run; j++) {
+            uint32_t value = 0;
+            int shift = 0;
+            while (pos < in.size()) {
+                uint8_t byte = in[pos++];
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+                if ((byte & 0x80) == 0) {
+                    break;
+                }
+            }
+            words[i++] = static_cast<uint16_t>(value);
+        }
+    }
+    return i == pageWords;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef COMPRESSED_POOL_H
+#define COMPRESSED_POOL_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// In-memory tier in front of the backing store file, keyed by backing store slot.
+// Pages are stored compressed up to a byte capacity; storing past it pushes the
+// oldest pages out, and the caller writes those to the file. Pages that do not
+// compress are refused so they go straight to the file.
+//
+// Simulated pages are mostly zero or small values, so the encoding is a stream
+// of tokens over 16-bit words:
+//   0nnnnnnn  - n + 1 zero words
+//   1nnnnnnn  - n + 1 literal words follow, each as a 1-3 byte varint
+class CompressedPool {
+public:
+    explicit CompressedPool(size_t pageWords);
+
+    // Compressed bytes the pool may hold; 0 disables it (and drops every page)
+    void setCapacity(size_t bytes, std::vector<std::pair<size_t, std::vector<uint16_t>>>& spilled);
+    size_t getCapacity() const { return capacity.load(std::memory_order_relaxed); }
+    bool isEnabled() const { return getCapacity() > 0; }
+
+    // Keep the page for slot, replacing any older copy. False if the page does not
+    // compress; the older copy is dropped then, so the caller's write is the only one.
+    // Pages pushed out to make room are appended to spilled, oldest first.
+    bool store(size_t slot, const uint16_t* data, std::vector<std::pair<size_t, std::vector<uint16_t>>>& spilled);
+    bool load(size_t slot, uint16_t* data);
+    bool contains(size_t slot) const;
+    void erase(size_t slot);
+    void clear();
+
+    // Statistics, safe to read at any time
+    size_t getStoredPages() const { return storedPages.load(std::memory_order_relaxed); }
+    size_t getStoredBytes() const { return storedBytes.load(std::memory_order_relaxed); }
+    size_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    size_t getSpills() const { return spills.load(std::memory_order_relaxed); }
+    size_t getRejects() const { return rejects.load(std::memory_order_relaxed); }
+    double getCompressionRatio() const;   // Original size over compressed size of the stored pages
+
+private:
+    struct Entry {
+        std::vector<uint8_t> data;
+        uint64_t sequence;
+    };
+
+    void compress(const uint16_t* words, std::vector<uint8_t>& out) const;
+    bool decompress(const std::vector<uint8_t>& in, uint16_t* words) const;
+    void removeLocked(std::unordered_map<size_t, Entry>::iterator it);
+    bool isLive(const std::pair<size_t, uint64_t>& position) const;
+
+    size_t pageWords;
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, Entry> entries;
+    // (slot, sequence) oldest first. Pairs of replaced or erased pages are skipped, and
+    // dropped in one pass once they outnumber the live ones, so order stays O(entries)
+    std::deque<std::pair<size_t, uint64_t>> order;
+    uint64_t nextSequence = 1;
+
+    std::atomic<size_t> capacity{ 0 };
+    std::atomic<size_t> storedPages{ 0 };
+    std::atomic<size_t> storedBytes{ 0 };
+    std::atomic<size_t> hits{ 0 };
+    std::atomic<size_t> spills{ 0 };     // Pages pushed out to the file
+    std::atomic<size_t> rejects{ 0 };    // Pages that did not compress
+};
+
+#endif // COMPRESSED_POOL_H
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
 
 FCFSScheduler::FCFSScheduler(int cores, int delaysPerExec)
 	: Scheduler(cores), delaysPerExec_(delaysPerExec) {
@@ -29,13 +30,27 @@ void FCFSScheduler::cpuWorker(int coreId) {
 		lock.unlock();
 
 		if (process) {
+			// Hold the process back while its working set does not fit beside those running
+			if (globalMemoryManager && !globalMemoryManager->reserveWorkingSet(process->getMemoryHandle())) {
+				{
+					std::lock_guard<std::mutex> queueLock(queueMutex);
+					process->setStatus("READY");
+					readyQueue.push(process);
+					cpuCores[coreId].isBusy = false;
+					cpuCores[coreId].currentProcess = nullptr;
+				}
+				schedulerCV.notify_all();
+				std::this_thread::sleep_for(std::chrono::milliseconds(std::max(delaysPerExec_, 1)));
+				continue;
+			}
+
 			while (process->getCurrentBurst() < process->getTotalBurst() &&
 				cpuCores[coreId].running) {
 				
 				// Trigger memory access for demand paging before instruction execution
 				if (globalMemoryManager) {
 					uint32_t virtualAddress = process->getCurrentBurst() * 4; // 4 bytes per instruction simulation
-					globalMemoryManager->accessMemory(process, virtualAddress, false);
+					globalMemoryManager->accessMemory(process, virtualAddress, false, coreId);
 				}
 				
 				process->executeInstruction(coreId);
@@ -44,12 +59,24 @@ void FCFSScheduler::cpuWorker(int coreId) {
 				if (!cpuCores[coreId].running) break;
 			}
 
+			if (globalMemoryManager) {
+				globalMemoryManager->releaseWorkingSet(process->getMemoryHandle());
+			}
+
 			{
 				std::lock_guard<std::mutex> finishedLock(finishedMutex);
 				finishedProcesses.push_back(process);
 				process->setStatus("FINISHED");
 			}
 
+			// Release the process memory and schedule whichever waiting processes now fit
+			if (globalMemoryManager) {
+				globalMemoryManager->deallocateMemory(process);
+				for (auto& admitted : globalMemoryManager->admitWaitingProcesses()) {
+					addProcess(admitted);
+				}
+			}
+
 			{
 				std::lock_guard<std::mutex> coreLock(queueMutex);
 				cpuCores[coreId].isBusy = false;
@@ -0,0 +1,98 @@
+#include "MemoryBenchmark.h"
+#include "MemoryManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    const size_t BENCH_PROCESS_MEMORY = 4096;
+    const int RESIDENT_OPS_PER_CORE = 200000;
+    const int FAULTING_OPS_PER_CORE = 20000;
+    const char* BENCH_BACKING_STORE = "csopesy-membench.bin";
+
+    // Millions of memory accesses per second with one process per core.
+    // forceFaults mixes in the instruction-fetch simulation, which evicts and
+    // reloads pages, so the frame allocator and backing store are exercised too.
+    double runWorkload(int cores, int opsPerCore, bool forceFaults) {
+        // Enough frames for every process, so only forced faults reach the backing store
+        MemoryManager manager(BENCH_PROCESS_MEMORY * static_cast<size_t>(cores), BENCH_BACKING_STORE);
+
+        std::vector<ProcessHandle> handles;
+        for (int core = 0; core < cores; core++) {
+            handles.push_back(manager.allocateMemory("bench_" + std::to_string(core), BENCH_PROCESS_MEMORY));
+        }
+
+        std::atomic<bool> started{ false };
+        std::vector<std::thread> workers;
+        for (int core = 0; core < cores; core++) {
+            workers.emplace_back([&, core]() {
+                ProcessHandle handle = handles[core];
+                uint32_t state = static_cast<uint32_t>(core) * 2654435761u + 1;
+
+                while (!started.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+
+                for (int i = 0; i < opsPerCore; i++) {
+                    state = state * 1664525u + 1013904223u;
+                    size_t address = ((state >> 8) % (BENCH_PROCESS_MEMORY / 2)) * 2;
+
+                    if (forceFaults && i % 8 == 0) {
+                        manager.simulateInstructionMemoryAccess(handle);
+                    }
+                    if (state & 1) {
+                        manager.writeMemory(handle, address, static_cast<uint16_t>(i), core);
+                    } else {
+                        manager.readMemory(handle, address, core);
+                    }
+                }
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        started.store(true, std::memory_order_release);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double totalOps = static_cast<double>(cores) * static_cast<double>(opsPerCore);
+        return seconds > 0.0 ? totalOps / seconds / 1e6 : 0.0;
+    }
+}
+
+void runMemoryBenchmark(int maxThreads) {
+    std::cout << "Memory manager scaling benchmark (" << BENCH_PROCESS_MEMORY << " bytes per process, "
+              << std::thread::hardware_concurrency() << " hardware threads)\n";
+    std::cout << "-----------------------------------------------------------------\n";
+    std::cout << std::left << std::setw(8) << "Cores"
+              << std::setw(18) << "Resident Mops/s" << std::setw(10) << "Speedup"
+              << std::setw(18) << "Faulting Mops/s" << "Speedup\n";
+    std::cout << "-----------------------------------------------------------------\n";
+
+    double residentBase = 0.0;
+    double faultingBase = 0.0;
+    for (int cores = 1; cores <= maxThreads; cores *= 2) {
+        double resident = runWorkload(cores, RESIDENT_OPS_PER_CORE, false);
+        double faulting = runWorkload(cores, FAULTING_OPS_PER_CORE, true);
+        if (cores == 1) {
+            residentBase = resident;
+            faultingBase = faulting;
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(8) << cores
+                  << std::setw(18) << resident
+                  << std::setw(10) << (residentBase > 0.0 ? resident / residentBase : 0.0)
+                  << std::setw(18) << faulting
+                  << (faultingBase > 0.0 ? faulting / faultingBase : 0.0) << "\n";
+    }
+    std::cout << "-----------------------------------------------------------------\n";
+
+    std::remove(BENCH_BACKING_STORE);
+}
@@ -0,0 +1,11 @@
+#pragma once
+#ifndef MEMORY_BENCHMARK_H
+#define MEMORY_BENCHMARK_H
+
+// Scaling benchmark for MemoryManager (the "membench" command).
+// Runs the same per-core workload with 1, 2, 4, ... maxThreads cores, each core
+// driving its own process on a private MemoryManager, and prints throughput for
+// resident-page accesses and for a mix that keeps forcing page faults.
+void runMemoryBenchmark(int maxThreads = 64);
+
+#endif // MEMORY_BENCHMARK_H
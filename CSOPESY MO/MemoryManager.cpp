@@ -5,30 +5,58 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <thread>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    // Checksum of one frame for the deduplication scanner. Eight independent 32-bit
+    // FNV-style lanes each take one word of every 32-byte block. Vector units have a
+    // 32-bit multiply (SSE4.1/AVX2 pmulld, NEON, or pmuludq pairs on plain SSE2) but
+    // no 64-bit one before AVX-512, so these lanes vectorize where 64-bit ones stay
+    // scalar. Words are loaded with memcpy to stay alias-safe, and the lanes are
+    // folded into a 64-bit hash at the end.
+    uint64_t checksumFrame(const uint16_t* data, size_t words) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        size_t length = words * sizeof(uint16_t);
+        
+        uint32_t lanes[8] = { 0x811C9DC5u, 0x9E3779B9u, 0x85EBCA6Bu, 0xC2B2AE35u,
+                              0x27D4EB2Fu, 0x165667B1u, 0xD3A2646Cu, 0xFD7046C5u };
+        size_t offset = 0;
+        for (; offset + 32 <= length; offset += 32) {
+            uint32_t block[8];
+            std::memcpy(block, bytes + offset, sizeof(block));
+            for (int lane = 0; lane < 8; lane++) {
+                lanes[lane] = (lanes[lane] ^ block[lane]) * 0x01000193u;
+            }
+        }
+        
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (int lane = 0; lane < 8; lane++) {
+            hash = (hash ^ lanes[lane]) * 0x100000001B3ull;
+        }
+        for (; offset < length; offset++) {
+            hash = (hash ^ bytes[offset]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
 
 
-MemoryManager::MemoryManager(size_t totalMem) : totalMemory(totalMem), PAGE_SIZE(256), FRAME_SIZE(256) {
+MemoryManager::MemoryManager(size_t totalMem, const std::string& backingStoreFile)
+    : totalMemory(totalMem), backingStoreFile(backingStoreFile), PAGE_SIZE(256), FRAME_SIZE(256) {
     // Initialize demand paging system
     numFrames = totalMemory / FRAME_SIZE;
-    frames.reserve(numFrames);
-    for (size_t i = 0; i < numFrames; i++) {
-        frames.emplace_back(i, FRAME_SIZE);
-    }
+    initializeAddressTranslation();
+    initializeFrames();
+    replacementPolicy = createReplacementPolicy("fifo", numFrames);
     
-    backingStoreFile = "csopesy-backing-store.txt";
     initializeBackingStore();
     
     maxOverallMemory_ = static_cast<int>(totalMemory);
     memoryPerFrame_ = static_cast<int>(FRAME_SIZE);
     totalFrames_ = static_cast<int>(numFrames);
     
-    // Initialize frames for legacy system
-    frames_.reserve(totalFrames_);
-    for (int i = 0; i < totalFrames_; ++i) {
-        frames_.emplace_back(i);
-        freeFrames_.push(i);
-    }
-    
     // Initialize statistics
     stats_.totalMemory = maxOverallMemory_;
     stats_.freeMemory = maxOverallMemory_;
@@ -44,25 +72,17 @@ MemoryManager::MemoryManager(size_t totalMem) : totalMemory(totalMem), PAGE_SIZE
 
 MemoryManager::MemoryManager(int maxOverallMemory, int memoryPerFrame) 
     : maxOverallMemory_(maxOverallMemory), memoryPerFrame_(memoryPerFrame),
-      backingStoreFile("csopesy-backing-store.txt"),
+      backingStoreFile("csopesy-backing-store.bin"),
       PAGE_SIZE(static_cast<size_t>(memoryPerFrame)), FRAME_SIZE(static_cast<size_t>(memoryPerFrame)) {
     
     totalFrames_ = maxOverallMemory_ / memoryPerFrame_;
     
-    // Frame Initialization
-    frames_.reserve(totalFrames_);
-    for (int i = 0; i < totalFrames_; ++i) {
-        frames_.emplace_back(i, FRAME_SIZE);
-        freeFrames_.push(i);
-    }
-    
     // Initialize Configs
     totalMemory = static_cast<size_t>(maxOverallMemory);
     numFrames = static_cast<size_t>(totalFrames_);
-    frames.reserve(numFrames);
-    for (size_t i = 0; i < numFrames; i++) {
-        frames.emplace_back(i, FRAME_SIZE);
-    }
+    initializeAddressTranslation();
+    initializeFrames();
+    replacementPolicy = createReplacementPolicy("fifo", numFrames);
     
     // Initialize statistics
     stats_.totalMemory = maxOverallMemory_;
@@ -80,361 +100,1857 @@ MemoryManager::MemoryManager(int maxOverallMemory, int memoryPerFrame)
 }
 
 MemoryManager::~MemoryManager() {
-    // Object Destructor
+    stopDedupScanner();
+    stopPrefetcher();
+    stopReclaimer();
 }
 
-// Initialize backing store file
+// Initialize backing store file (binary, one fixed-size slot per page)
 void MemoryManager::initializeBackingStore() {
-    std::ofstream file(backingStoreFile, std::ios::out | std::ios::trunc);
-    if (file.is_open()) {
-        file << "CSOPESY Backing Store - Page Data\n";
-        file << "Format: ProcessName:PageNumber:Data\n";
-        file.close();
+    if (backingStore) {
+        backingStore->reset();
+    } else {
+        backingStore = std::make_unique<BackingStore>(backingStoreFile, PAGE_SIZE);
+    }
+}
+
+// Pick the translation for the configured page size. mem-per-frame is not required
+// to be a power of two, so the division path stays for the odd sizes.
+void MemoryManager::initializeAddressTranslation() {
+    pageShift = NO_PAGE_SHIFT;
+    pageOffsetMask = 0;
+    if (PAGE_SIZE > 0 && (PAGE_SIZE & (PAGE_SIZE - 1)) == 0) {
+        pageShift = 0;
+        while ((static_cast<size_t>(1) << pageShift) < PAGE_SIZE) {
+            pageShift++;
+        }
+        pageOffsetMask = PAGE_SIZE - 1;
+    }
+}
+
+// Allocate every frame in one cache-line aligned arena and reset the frame table.
+// Every frame starts free; push in reverse so frame 0 is handed out first.
+void MemoryManager::initializeFrames() {
+    wordsPerFrame = FRAME_SIZE / 2;
+    zeroPage.assign(wordsPerFrame, 0);
+    frameChecksums.assign(numFrames, 0);
+    dedupCandidates.clear();
+    dedupCursor = 0;
+    size_t arenaWords = std::max<size_t>(numFrames * wordsPerFrame, 1);
+    
+    uint16_t* arena = static_cast<uint16_t*>(
+        ::operator new[](arenaWords * sizeof(uint16_t), std::align_val_t(AlignedArenaDeleter::ALIGNMENT)));
+    std::fill(arena, arena + arenaWords, static_cast<uint16_t>(0));
+    physicalMemory.reset(arena);
+    
+    frameTable.resize(numFrames);
+    
+    tlbs.clear();
+    for (size_t core = 0; core < MAX_TLB_CORES; core++) {
+        tlbs.push_back(std::make_unique<TLB>());
+    }
+    
+    freeFrameList.clear();
+    freeFrameList.reserve(numFrames);
+    for (size_t i = numFrames; i > 0; i--) {
+        freeFrameList.push_back(i - 1);
     }
 }
 
-// Create virtual pages for a process
-void MemoryManager::createProcessPages(const std::string& processName, size_t totalSize) {
+// Create virtual pages for a process and return its process id. A sparse process
+// is not charged for its pages until it touches them.
+uint32_t MemoryManager::createProcessPages(const std::string& processName, size_t totalSize, bool sparse) {
     size_t numPages = (totalSize + PAGE_SIZE - 1) / PAGE_SIZE;  // Ceiling division
-    std::vector<Page> pages;
-    pages.reserve(numPages);
     
-    for (size_t i = 0; i < numPages; i++) {
-        Page page(i, processName, PAGE_SIZE);
-        page.data.resize(PAGE_SIZE / 2, 0);  // uint16 values per page
-        pages.emplace_back(std::move(page));
+    uint32_t processId;
+    if (!freeProcessIds.empty()) {
+        processId = freeProcessIds.back();
+        freeProcessIds.pop_back();
+    } else {
+        processId = static_cast<uint32_t>(pageTables.size());
+        pageTables.emplace_back();
+    }
+    
+    ProcessPageTable& table = pageTables[processId];
+    table.processName = processName;
+    table.inUse = true;
+    table.pages.assign(numPages);
+    table.committedMemory = sparse ? 0 : numPages * PAGE_SIZE;
+    table.residentPages = 0;
+    table.swappedPages = 0;
+    table.lastFaultPage = static_cast<size_t>(-1);
+    table.readaheadEnd = 0;
+    table.readaheadWindow = 0;
+    table.instructions = 0;
+    table.windowStart = 0;
+    table.windowFaults = 0;
+    table.localHand = 0;
+    table.frameQuota = std::min(numPages, MIN_FRAME_QUOTA);
+    table.faultRate = 0;
+    table.swappedOut = false;
+    table.residentSet.clear();
+    {
+        std::lock_guard<std::mutex> prefetchLock(prefetchMutex);
+        table.generation++;
+        table.prefetchesQueued = 0;
+    }
+    
+    processIds[processName] = processId;
+    allocatedMemory += table.committedMemory;
+    return processId;
+}
+
+// Virtual memory handed out to all processes
+size_t MemoryManager::getUsedMemory() const {
+    return allocatedMemory.load(std::memory_order_relaxed);
+}
+
+// Most virtual memory that may be handed out: physical frames plus swap space
+size_t MemoryManager::getCommitLimit() const {
+    return totalMemory + swapCapacity;
+}
+
+// Find a free frame
+size_t MemoryManager::findFreeFrame() {
+    if (freeFrameList.empty()) {
+        return static_cast<size_t>(-1);  // No free frame
+    }
+    size_t frameNumber = freeFrameList.back();
+    freeFrameList.pop_back();
+    return frameNumber;
+}
+
+// Free a frame for processId by evicting a victim (caller holds frameMutex and the
+// lock of processId). The owners of the victim are only try_locked; a busy owner is
+// actively using its pages, so the frame is passed over and another victim is tried.
+// Passed-over frames go back to the policy with their history once a victim is found.
+// ownersBusy reports that every candidate was busy.
+size_t MemoryManager::reclaimFrame(uint32_t processId, bool& ownersBusy) {
+    std::vector<size_t> skipped;
+    size_t frameNumber = static_cast<size_t>(-1);
+    
+    for (size_t attempt = 0; attempt <= numFrames; attempt++) {
+        size_t victimFrame = selectVictimFrame();
+        if (victimFrame == static_cast<size_t>(-1)) {
+            break;  // No pages left to evict
+        }
+        
+        // The inverted table tells us who owns the victim; paging it out frees the frame
+        std::vector<std::unique_lock<std::mutex>> ownerLocks;
+        if (!lockSharers(victimFrame, processId, ownerLocks)) {
+            skipped.push_back(victimFrame);
+            continue;
+        }
+        
+        evictFrame(victimFrame);
+        frameNumber = findFreeFrame();
+        break;
+    }
+    
+    returnSkippedFrames(skipped);
+    ownersBusy = frameNumber == static_cast<size_t>(-1) && !skipped.empty();
+    return frameNumber;
+}
+
+// Evict whatever occupies the frame (caller holds frameMutex and the locks of every
+// page mapping it). A huge page goes out whole unless it turns out to be sparsely used.
+void MemoryManager::evictFrame(size_t frameNumber) {
+    if (isHugeFrame(frameNumber) && evictHugePage(frameTable.owner[frameNumber], frameTable.page[frameNumber])) {
+        return;
+    }
+    
+    // A shared frame is written back once, then every page mapping it lets go
+    if (frameTable.isShared(frameNumber)) {
+        writeBackFrame(frameNumber);
+        while (frameTable.isShared(frameNumber)) {
+            const FrameTable::Mapping& sharer = frameTable.sharers[frameNumber].back();
+            unmapSharedPage(sharer.processId, sharer.pageNumber);
+        }
+    }
+    pageOut(frameTable.owner[frameNumber], frameTable.page[frameNumber]);
+}
+
+// Invalidate every TLB entry for the frame, then wait out TLB hits already using it.
+// Must run before the contents are written back or the frame changes hands.
+void MemoryManager::retireFrameTag(size_t frameNumber) {
+    frameTable.tag[frameNumber].store(0);
+    while (frameTable.pins[frameNumber].load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+// Return a frame to the free list and clear its inverted table entry
+void MemoryManager::releaseFrame(size_t frameNumber) {
+    if (frameNumber >= numFrames || !frameTable.isOccupied(frameNumber)) return;
+    
+    retireFrameTag(frameNumber);
+    frameTable.owner[frameNumber] = FrameTable::NO_OWNER;
+    frameTable.page[frameNumber] = 0;
+    frameTable.occupied[frameNumber] = 0;
+    frameTable.dirty[frameNumber] = 0;
+    frameTable.accessed[frameNumber].store(0, std::memory_order_relaxed);
+    if (frameTable.speculative[frameNumber] == FrameTable::LOADED_BY_READAHEAD) {
+        readaheadWaste.fetch_add(1, std::memory_order_relaxed);
+    } else if (frameTable.speculative[frameNumber] == FrameTable::LOADED_BY_PREFETCH) {
+        prefetchWaste.fetch_add(1, std::memory_order_relaxed);
+    }
+    frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+    freeFrameList.push_back(frameNumber);
+    residentPages--;
+    replacementPolicy->frameReleased(frameNumber);
+}
+
+// Select victim frame using the configured replacement policy
+size_t MemoryManager::selectVictimFrame() {
+    return replacementPolicy->selectVictim();
+}
+
+// Hand frames passed over during one victim search back to the policy, most recently
+// selected first. One evicted along with a victim (a huge page goes out whole) is gone.
+void MemoryManager::returnSkippedFrames(const std::vector<size_t>& skipped) {
+    for (auto it = skipped.rbegin(); it != skipped.rend(); ++it) {
+        if (frameTable.isOccupied(*it)) {
+            replacementPolicy->frameSkipped(*it);
+        }
+    }
+}
+
+// Excludes every memory access, since the fast path references the policy without frameMutex.
+// TLB hits take no lock at all, so every resident frame is retagged to drain them first.
+bool MemoryManager::setReplacementPolicy(const std::string& policyName) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    std::unique_ptr<ReplacementPolicy> policy = createReplacementPolicy(policyName, numFrames);
+    if (!policy) {
+        return false;
+    }
+    
+    // Hand over any pages that are already resident
+    for (size_t frameNumber = 0; frameNumber < numFrames; frameNumber++) {
+        if (frameTable.isOccupied(frameNumber)) {
+            retireFrameTag(frameNumber);
+            frameTable.tag[frameNumber].store(nextFrameTag++);
+            policy->frameLoaded(frameNumber);
+        }
+    }
+    replacementPolicy = std::move(policy);
+    return true;
+}
+
+std::string MemoryManager::getReplacementPolicyName() const {
+    std::lock_guard<std::mutex> lock(frameMutex);
+    return replacementPolicy->getName();
+}
+
+// Shrinking below what is already committed only blocks new admissions
+void MemoryManager::setSwapCapacity(size_t bytes) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    swapCapacity = bytes;
+}
+
+size_t MemoryManager::getSwapCapacity() const {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    return swapCapacity;
+}
+
+void MemoryManager::setPrefetchBudget(size_t pages) {
+    stopPrefetcher();
+    prefetchBudget = pages;
+    if (prefetchBudget > 0) {
+        prefetcherStopping = false;
+        prefetcherThread = std::thread(&MemoryManager::prefetcherLoop, this);
+    }
+}
+
+// Called by the process itself before it runs the instructions that need the pages.
+// Pages already resident, never written back or already queued are skipped.
+void MemoryManager::prefetchPages(ProcessHandle handle, const std::vector<size_t>& virtualAddresses) {
+    if (prefetchBudget == 0) {
+        return;
+    }
+    
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(handle)) {
+        return;
+    }
+    ProcessPageTable& table = pageTables[handle];
+    std::lock_guard<std::mutex> processLock(table.mutex);
+    
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> prefetchLock(prefetchMutex);
+        for (size_t virtualAddress : virtualAddresses) {
+            if (!isValidVirtualAddress(table, virtualAddress)) {
+                continue;
+            }
+            size_t pageNumber = virtualToPageNumber(virtualAddress);
+            Page& page = table.pages[pageNumber];
+            if (page.isInMemory || page.prefetchQueued || page.isZeroMapped()) {
+                continue;
+            }
+            if (table.prefetchesQueued >= prefetchBudget) {
+                prefetchDropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            
+            page.prefetchQueued = true;
+            table.prefetchesQueued++;
+            prefetchQueue.push_back({ static_cast<uint32_t>(handle), table.generation, pageNumber });
+            prefetchRequests.fetch_add(1, std::memory_order_relaxed);
+            queued = true;
+        }
+    }
+    if (queued) {
+        prefetchCV.notify_one();
+    }
+}
+
+void MemoryManager::prefetcherLoop() {
+    while (true) {
+        PrefetchRequest request;
+        {
+            std::unique_lock<std::mutex> lock(prefetchMutex);
+            prefetchCV.wait(lock, [this] { return prefetcherStopping || !prefetchQueue.empty(); });
+            if (prefetcherStopping) {
+                return;
+            }
+            request = prefetchQueue.front();
+            prefetchQueue.pop_front();
+        }
+        prefetchPage(request);
+    }
+}
+
+// Load one requested page the way a fault would, without counting a fault or
+// adapting the readahead window. The page is marked so its first use counts as a hit.
+// Only a free frame is used: a speculative page never pushes out a resident one.
+void MemoryManager::prefetchPage(const PrefetchRequest& request) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(static_cast<ProcessHandle>(request.processId))) {
+        return;
+    }
+    ProcessPageTable& table = pageTables[request.processId];
+    std::lock_guard<std::mutex> processLock(table.mutex);
+    {
+        std::lock_guard<std::mutex> prefetchLock(prefetchMutex);
+        if (table.generation != request.generation) {
+            return;  // Queued for a process that has since been deallocated
+        }
+        table.pages[request.pageNumber].prefetchQueued = false;
+        table.prefetchesQueued--;
+    }
+    
+    if (table.pages[request.pageNumber].isInMemory) {
+        return;  // Faulted in by the process before the prefetcher got to it
+    }
+    if (table.pages[request.pageNumber].huge) {
+        return;  // Part of a huge page, which only comes back whole on a fault
+    }
+    
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    size_t frameNumber = findFreeFrame();
+    if (frameNumber == static_cast<size_t>(-1)) {
+        return;  // No free frame; the process will fault instead
+    }
+    
+    pageIn(request.processId, request.pageNumber, frameNumber);
+    frameTable.speculative[frameNumber] = FrameTable::LOADED_BY_PREFETCH;
+    prefetchedPages.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryManager::stopPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetcherStopping = true;
+        prefetchQueue.clear();
+    }
+    prefetchCV.notify_one();
+    if (prefetcherThread.joinable()) {
+        prefetcherThread.join();
+    }
+}
+
+// Excludes every memory access, since the fault path reads the window under a process lock only
+void MemoryManager::setWorkingSetWindow(size_t instructions) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    workingSetWindow = instructions;
+}
+
+bool MemoryManager::reserveWorkingSet(ProcessHandle handle) {
+    if (workingSetWindow == 0) {
+        return true;
+    }
+    
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(handle)) {
+        return true;
+    }
+    
+    std::lock_guard<std::mutex> workingSetLock(workingSetMutex);
+    size_t committed = 0;
+    for (uint32_t processId : runningProcesses) {
+        committed += pageTables[processId].frameQuota.load(std::memory_order_relaxed);
+    }
+    size_t needed = pageTables[handle].frameQuota.load(std::memory_order_relaxed);
+    if (!runningProcesses.empty() && committed + needed > numFrames) {
+        heldBackProcesses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    runningProcesses.push_back(static_cast<uint32_t>(handle));
+    return true;
+}
+
+void MemoryManager::releaseWorkingSet(ProcessHandle handle) {
+    std::lock_guard<std::mutex> workingSetLock(workingSetMutex);
+    auto it = std::find(runningProcesses.begin(), runningProcesses.end(), static_cast<uint32_t>(handle));
+    if (it != runningProcesses.end()) {
+        runningProcesses.erase(it);
+    }
+}
+
+// End of a window (caller holds the process lock): a high fault rate means the
+// working set is larger than the quota, a low one that the quota has room to spare
+void MemoryManager::updateWorkingSet(ProcessPageTable& table) {
+    size_t elapsed = table.instructions - table.windowStart;
+    size_t rate = table.windowFaults * 1000 / elapsed;
+    size_t quota = table.frameQuota.load(std::memory_order_relaxed);
+    
+    if (rate > PFF_HIGH) {
+        quota = std::min(table.pages.size(), quota + std::max<size_t>(1, quota / 2));
+    } else if (rate < PFF_LOW && quota > MIN_FRAME_QUOTA) {
+        quota--;
+    }
+    table.frameQuota.store(quota, std::memory_order_relaxed);
+    table.faultRate.store(rate, std::memory_order_relaxed);
+    table.windowStart = table.instructions;
+    table.windowFaults = 0;
+}
+
+// Evict pages of processId until it is below its quota, and return a frame for its
+// fault (caller holds frameMutex and the process lock). Pages the policy has seen
+// used recently are passed over once; shared frames are left to global replacement.
+size_t MemoryManager::replaceLocalPage(uint32_t processId) {
+    ProcessPageTable& table = pageTables[processId];
+    size_t numPages = table.pages.size();
+    
+    while (table.residentPages >= table.frameQuota.load(std::memory_order_relaxed)) {
+        size_t victim = static_cast<size_t>(-1);
+        size_t fallback = static_cast<size_t>(-1);
+        auto consider = [&](size_t pageNumber, const Page& page) {
+            if (!page.isInMemory || frameTable.isShared(page.frameNumber)) {
+                return true;
+            }
+            if (!replacementPolicy->isRecentlyReferenced(page.frameNumber)) {
+                victim = pageNumber;
+                return false;
+            }
+            if (fallback == static_cast<size_t>(-1)) {
+                fallback = pageNumber;
+            }
+            return true;
+        };
+        // From the hand to the end, then wrap around; untouched leaves are skipped
+        if (table.pages.forEachPageUntil(table.localHand, numPages, consider)) {
+            table.pages.forEachPageUntil(0, table.localHand, consider);
+        }
+        if (victim == static_cast<size_t>(-1)) {
+            victim = fallback;
+        }
+        if (victim == static_cast<size_t>(-1)) {
+            return static_cast<size_t>(-1);
+        }
+        
+        table.localHand = (victim + 1) % numPages;
+        pageOut(processId, victim);
+    }
+    return findFreeFrame();
+}
+
+void MemoryManager::setProcessSwapping(bool enabled) {
+    processSwapping = enabled;
+}
+
+bool MemoryManager::isOversubscribed() const {
+    size_t activeMemory = allocatedMemory.load() - swappedOutMemory.load();
+    return activeMemory > numFrames * PAGE_SIZE;
+}
+
+bool MemoryManager::hasHeadroomFor(ProcessHandle handle) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(handle)) {
+        return false;
+    }
+    
+    ProcessPageTable& table = pageTables[handle];
+    std::lock_guard<std::mutex> processLock(table.mutex);
+    size_t needed = std::min(table.residentSet.size(), numFrames);
+    return numFrames - residentPages.load() >= needed;
+}
+
+// Dirty pages get a fresh run of slots so they go out in one write; clean pages
+// already match their slot and are simply dropped. Frames shared copy-on-write
+// stay with the other processes mapping them.
+bool MemoryManager::swapOutProcess(ProcessHandle handle) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(handle)) {
+        return false;
+    }
+    
+    uint32_t processId = static_cast<uint32_t>(handle);
+    ProcessPageTable& table = pageTables[processId];
+    std::lock_guard<std::mutex> processLock(table.mutex);
+    if (table.swappedOut) {
+        return false;
+    }
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    // Retiring the tags first keeps TLB hits from writing a frame while it is copied
+    std::vector<size_t> resident;
+    std::vector<size_t> dirty;
+    table.pages.forEachPage([&](size_t pageNumber, Page& page) {
+        if (page.huge) {
+            demoteHugePage(table, pageNumber);
+        }
+        if (!page.isInMemory || frameTable.isShared(page.frameNumber)) {
+            return;
+        }
+        retireFrameTag(page.frameNumber);
+        resident.push_back(pageNumber);
+        if (frameTable.isDirty(page.frameNumber)) {
+            dirty.push_back(pageNumber);
+        }
+    });
+    
+    if (!dirty.empty()) {
+        size_t firstSlot = backingStore->allocateSlots(dirty.size());
+        std::vector<const uint16_t*> sources;
+        for (size_t i = 0; i < dirty.size(); i++) {
+            Page& page = table.pages[dirty[i]];
+            backingStore->releaseSlot(page.backingSlot);
+            page.backingSlot = firstSlot + i;
+            sources.push_back(frameData(page.frameNumber));
+            frameTable.dirty[page.frameNumber] = 0;
+        }
+        if (!backingStore->writePages(firstSlot, dirty.size(), sources.data())) {
+            std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+        }
+    }
+    dirtyEvictions.fetch_add(dirty.size(), std::memory_order_relaxed);
+    cleanEvictions.fetch_add(resident.size() - dirty.size(), std::memory_order_relaxed);
+    
+    for (size_t pageNumber : resident) {
+        Page& page = table.pages[pageNumber];
+        releaseFrame(page.frameNumber);
+        page.isInMemory = false;
+        page.frameNumber = static_cast<size_t>(-1);
+        page.copyOnWrite = false;
+        table.residentPages--;
+        if (page.backingSlot != BackingStore::NO_SLOT) {
+            table.swappedPages++;
+            swappedPages++;
+        }
+        incrementPagesOut();
+    }
+    
+    bulkPagesOut.fetch_add(resident.size(), std::memory_order_relaxed);
+    processSwapOuts.fetch_add(1, std::memory_order_relaxed);
+    table.residentSet = std::move(resident);
+    table.swappedOut = true;
+    swappedOutMemory += table.committedMemory;
+    return true;
+}
+
+// The resident set is read in slot order, so each run of consecutive slots
+// (such as the dirty pages of the swap-out) takes a single read
+bool MemoryManager::swapInProcess(ProcessHandle handle) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    if (!isValidHandle(handle)) {
+        return false;
+    }
+    
+    uint32_t processId = static_cast<uint32_t>(handle);
+    ProcessPageTable& table = pageTables[processId];
+    std::lock_guard<std::mutex> processLock(table.mutex);
+    if (!table.swappedOut) {
+        return false;
+    }
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    std::vector<size_t> wanted;
+    for (size_t pageNumber : table.residentSet) {
+        const Page& page = table.pages[pageNumber];
+        if (!page.isInMemory && !page.isZeroMapped() && !page.huge) {
+            wanted.push_back(pageNumber);  // A huge page formed since comes back whole on a fault
+        }
+    }
+    std::sort(wanted.begin(), wanted.end(), [&table](size_t a, size_t b) {
+        return table.pages[a].backingSlot < table.pages[b].backingSlot;
+    });
+    
+    std::vector<size_t> pageNumbers;
+    std::vector<size_t> frames;
+    std::vector<uint16_t*> destinations;
+    for (size_t i = 0; i < wanted.size() && !freeFrameList.empty(); i++) {
+        const Page& page = table.pages[wanted[i]];
+        size_t frameNumber = findFreeFrame();
+        pageNumbers.push_back(wanted[i]);
+        frames.push_back(frameNumber);
+        destinations.push_back(frameData(frameNumber));
+        
+        bool runEnds = i + 1 == wanted.size() || freeFrameList.empty() ||
+                       table.pages[wanted[i + 1]].backingSlot != page.backingSlot + 1;
+        if (!runEnds) {
+            continue;
+        }
+        
+        size_t firstSlot = table.pages[pageNumbers.front()].backingSlot;
+        bool loaded = backingStore->readPages(firstSlot, pageNumbers.size(), destinations.data());
+        for (size_t j = 0; j < pageNumbers.size(); j++) {
+            if (!loaded) {
+                freeFrameList.push_back(frames[j]);
+                continue;
+            }
+            installPage(processId, pageNumbers[j], frames[j]);
+            bulkPagesIn.fetch_add(1, std::memory_order_relaxed);
+        }
+        pageNumbers.clear();
+        frames.clear();
+        destinations.clear();
+    }
+    
+    processSwapIns.fetch_add(1, std::memory_order_relaxed);
+    table.residentSet.clear();
+    table.swappedOut = false;
+    swappedOutMemory -= table.committedMemory;
+    return true;
+}
+
+// Existing huge pages keep to the old size, so every one is split first. Holding
+// tableMutex exclusively keeps every process lock free.
+bool MemoryManager::setHugePageSize(size_t bytes) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    size_t pages = PAGE_SIZE > 0 ? bytes / PAGE_SIZE : 0;
+    bool valid = bytes == 0 ||
+                 (pageShift != NO_PAGE_SHIFT && bytes % PAGE_SIZE == 0 && pages >= 2 &&
+                  (pages & (pages - 1)) == 0 && pages <= numFrames);
+    if (!valid) {
+        return false;
     }
     
-    processPages[processName] = std::move(pages);
+    for (ProcessPageTable& table : pageTables) {
+        if (!table.inUse) {
+            continue;
+        }
+        table.pages.forEachPage([&](size_t pageNumber, Page& page) {
+            if (page.huge) {
+                demoteHugePage(table, pageNumber);
+            }
+        });
+    }
+    hugePagePages = pages;
+    return true;
+}
+
+// A page of a huge page that is resident (caller holds the owner's lock)
+bool MemoryManager::isHugeFrame(size_t frameNumber) {
+    return frameTable.isOccupied(frameNumber) &&
+           pageTables[frameTable.owner[frameNumber]].pages[frameTable.page[frameNumber]].huge;
+}
+
+// Split the huge page holding pageNumber back into ordinary pages; they keep their
+// frames or slots (caller holds the owner's lock)
+void MemoryManager::demoteHugePage(ProcessPageTable& table, size_t pageNumber) {
+    size_t regionStart = pageNumber - pageNumber % hugePagePages;
+    for (size_t i = 0; i < hugePagePages; i++) {
+        table.pages[regionStart + i].huge = false;
+    }
+    hugeDemotions.fetch_add(1, std::memory_order_relaxed);
+}
+
+// First block of hugePagePages free frames on a block boundary (caller holds frameMutex)
+size_t MemoryManager::findHugeBlock() const {
+    for (size_t block = 0; block + hugePagePages <= numFrames; block += hugePagePages) {
+        bool free = true;
+        for (size_t frameNumber = block; frameNumber < block + hugePagePages && free; frameNumber++) {
+            free = !frameTable.isOccupied(frameNumber);
+        }
+        if (free) {
+            return block;
+        }
+    }
+    return static_cast<size_t>(-1);
+}
+
+// Empty the block around a victim chosen by the replacement policy, so the pages
+// evicted are ones the policy would have given up anyway. Blocks whose owners are
+// busy are passed over as in reclaimFrame (caller holds frameMutex and the lock of
+// processId).
+size_t MemoryManager::makeHugeBlock(uint32_t processId) {
+    std::vector<size_t> skipped;
+    size_t freedBlock = static_cast<size_t>(-1);
+    
+    for (size_t attempt = 0; attempt < numFrames / hugePagePages; attempt++) {
+        size_t victimFrame = selectVictimFrame();
+        if (victimFrame == static_cast<size_t>(-1)) {
+            break;
+        }
+        
+        size_t block = victimFrame - victimFrame % hugePagePages;
+        std::vector<std::unique_lock<std::mutex>> ownerLocks;
+        bool locked = true;
+        for (size_t frameNumber = block; frameNumber < block + hugePagePages && locked; frameNumber++) {
+            locked = !frameTable.isOccupied(frameNumber) || lockSharers(frameNumber, processId, ownerLocks);
+        }
+        if (!locked) {
+            skipped.push_back(victimFrame);
+            continue;
+        }
+        
+        // Evicting a huge page empties its whole block, so later frames may be free already
+        for (size_t frameNumber = block; frameNumber < block + hugePagePages; frameNumber++) {
+            if (frameTable.isOccupied(frameNumber)) {
+                evictFrame(frameNumber);
+            }
+        }
+        freedBlock = block;
+        break;
+    }
+    
+    returnSkippedFrames(skipped);
+    return freedBlock;
+}
+
+// Move a resident page to another free frame, keeping its dirty state (caller holds
+// frameMutex and the owner's lock)
+void MemoryManager::moveToFrame(uint32_t processId, size_t pageNumber, size_t frameNumber) {
+    Page& page = pageTables[processId].pages[pageNumber];
+    size_t oldFrame = page.frameNumber;
+    
+    retireFrameTag(oldFrame);
+    std::copy(frameData(oldFrame), frameData(oldFrame) + wordsPerFrame, frameData(frameNumber));
+    uint8_t dirty = frameTable.dirty[oldFrame];
+    frameTable.speculative[oldFrame] = FrameTable::NOT_SPECULATIVE;
+    releaseFrame(oldFrame);
+    
+    frameTable.owner[frameNumber] = processId;
+    frameTable.page[frameNumber] = static_cast<uint32_t>(pageNumber);
+    frameTable.occupied[frameNumber] = 1;
+    frameTable.dirty[frameNumber] = dirty;
+    frameTable.accessed[frameNumber].store(0, std::memory_order_relaxed);
+    frameTable.tag[frameNumber].store(nextFrameTag++);
+    page.frameNumber = frameNumber;
+    residentPages++;
+    replacementPolicy->frameLoaded(frameNumber);
+}
+
+// Bring in the whole region around a faulting page when it is, or has become, a huge
+// page: resident pages move into an aligned block and the rest are read in runs of
+// consecutive slots, which after a huge page eviction is a single read. False leaves
+// the fault to the ordinary path (caller holds frameMutex and the lock of processId).
+bool MemoryManager::faultHugePage(uint32_t processId, size_t pageNumber) {
+    ProcessPageTable& table = pageTables[processId];
+    size_t regionStart = pageNumber - pageNumber % hugePagePages;
+    if (regionStart + hugePagePages > table.pages.size()) {
+        return false;
+    }
+    
+    bool wasHuge = table.pages[pageNumber].huge;
+    if (!wasHuge) {
+        // Promote once at least half the region would be resident, and only private pages
+        size_t resident = 0;
+        for (size_t i = 0; i < hugePagePages; i++) {
+            const Page& page = table.pages[regionStart + i];
+            if (!page.isInMemory) {
+                continue;
+            }
+            if (page.copyOnWrite || frameTable.isShared(page.frameNumber)) {
+                return false;
+            }
+            resident++;
+        }
+        if ((resident + 1) * 2 < hugePagePages) {
+            return false;
+        }
+    }
+    
+    size_t block = findHugeBlock();
+    if (block == static_cast<size_t>(-1)) {
+        block = makeHugeBlock(processId);
+    }
+    if (block == static_cast<size_t>(-1)) {
+        if (wasHuge) {
+            demoteHugePage(table, regionStart);
+        }
+        return false;
+    }
+    freeFrameList.erase(std::remove_if(freeFrameList.begin(), freeFrameList.end(), [&](size_t frameNumber) {
+        return frameNumber >= block && frameNumber < block + hugePagePages;
+    }), freeFrameList.end());
+    
+    std::vector<size_t> run;
+    std::vector<uint16_t*> destinations;
+    for (size_t i = 0; i < hugePagePages; i++) {
+        Page& page = table.pages[regionStart + i];
+        if (page.isInMemory) {
+            moveToFrame(processId, regionStart + i, block + i);
+            continue;
+        }
+        if (page.backingSlot == BackingStore::NO_SLOT) {
+            std::copy(zeroPage.begin(), zeroPage.end(), frameData(block + i));
+            zeroFillFaults.fetch_add(1, std::memory_order_relaxed);
+            installPage(processId, regionStart + i, block + i);
+            continue;
+        }
+        run.push_back(i);
+        destinations.push_back(frameData(block + i));
+        
+        bool runEnds = i + 1 == hugePagePages || table.pages[regionStart + i + 1].isInMemory ||
+                       table.pages[regionStart + i + 1].backingSlot != page.backingSlot + 1;
+        if (!runEnds) {
+            continue;
+        }
+        
+        size_t firstSlot = table.pages[regionStart + run.front()].backingSlot;
+        if (!backingStore->readPages(firstSlot, run.size(), destinations.data())) {
+            for (uint16_t* data : destinations) {
+                std::fill(data, data + wordsPerFrame, static_cast<uint16_t>(0));
+            }
+        }
+        for (size_t j : run) {
+            installPage(processId, regionStart + j, block + j);
+        }
+        run.clear();
+        destinations.clear();
+    }
+    
+    for (size_t i = 0; i < hugePagePages; i++) {
+        table.pages[regionStart + i].huge = true;
+    }
+    if (wasHuge) {
+        hugePageFaults.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        hugePromotions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+// Evict the huge page holding pageNumber as a unit. If any page is dirty the whole
+// region goes to a fresh run of slots in one write, so it faults back with one read.
+// Fewer than half its pages used since they were loaded means the huge page is not
+// paying off: it is demoted and false returned, leaving the victim to go on its own
+// (caller holds frameMutex and the owner's lock).
+bool MemoryManager::evictHugePage(uint32_t processId, size_t pageNumber) {
+    ProcessPageTable& table = pageTables[processId];
+    size_t regionStart = pageNumber - pageNumber % hugePagePages;
+    
+    size_t used = 0;
+    size_t dirty = 0;
+    for (size_t i = 0; i < hugePagePages; i++) {
+        size_t frameNumber = table.pages[regionStart + i].frameNumber;
+        retireFrameTag(frameNumber);
+        used += frameTable.accessed[frameNumber].load(std::memory_order_relaxed);
+        dirty += frameTable.dirty[frameNumber];
+    }
+    
+    if (used * 2 < hugePagePages) {
+        for (size_t i = 0; i < hugePagePages; i++) {
+            frameTable.tag[table.pages[regionStart + i].frameNumber].store(nextFrameTag++);
+        }
+        demoteHugePage(table, regionStart);
+        return false;
+    }
+    
+    if (dirty > 0) {
+        size_t firstSlot = backingStore->allocateSlots(hugePagePages);
+        std::vector<const uint16_t*> sources;
+        for (size_t i = 0; i < hugePagePages; i++) {
+            Page& page = table.pages[regionStart + i];
+            backingStore->releaseSlot(page.backingSlot);
+            page.backingSlot = firstSlot + i;
+            sources.push_back(frameData(page.frameNumber));
+            frameTable.dirty[page.frameNumber] = 0;
+        }
+        if (!backingStore->writePages(firstSlot, hugePagePages, sources.data())) {
+            std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+        }
+    }
+    dirtyEvictions.fetch_add(dirty, std::memory_order_relaxed);
+    cleanEvictions.fetch_add(hugePagePages - dirty, std::memory_order_relaxed);
+    
+    for (size_t i = 0; i < hugePagePages; i++) {
+        Page& page = table.pages[regionStart + i];
+        releaseFrame(page.frameNumber);
+        page.isInMemory = false;
+        page.frameNumber = static_cast<size_t>(-1);
+        table.residentPages--;
+        if (page.backingSlot != BackingStore::NO_SLOT) {
+            table.swappedPages++;
+            swappedPages++;
+        }
+        incrementPagesOut();
+    }
+    hugePageEvictions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MemoryManager::setMaxReadahead(size_t pages) {
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    maxReadahead = pages;
+}
+
+void MemoryManager::setReclaimWatermarks(size_t lowFrames, size_t highFrames) {
+    stopReclaimer();
+    
+    // Leave at least one frame resident, or every pass would empty memory
+    size_t maxFree = numFrames > 0 ? numFrames - 1 : 0;
+    highWatermark = std::min(std::max(highFrames, lowFrames), maxFree);
+    lowWatermark = std::min(lowFrames, highWatermark);
+    
+    if (lowWatermark > 0) {
+        reclaimerStopping = false;
+        reclaimerThread = std::thread(&MemoryManager::reclaimerLoop, this);
+    }
+}
+
+// Called under frameMutex. Only the first request of a pass takes reclaimMutex,
+// which the reclaimer holds just while it waits, so a wakeup is never lost.
+void MemoryManager::wakeReclaimer() {
+    if (!reclaimRequested.exchange(true)) {
+        std::lock_guard<std::mutex> lock(reclaimMutex);
+        reclaimCV.notify_one();
+    }
+}
+
+void MemoryManager::stopReclaimer() {
+    {
+        std::lock_guard<std::mutex> lock(reclaimMutex);
+        reclaimerStopping = true;
+    }
+    reclaimCV.notify_one();
+    if (reclaimerThread.joinable()) {
+        reclaimerThread.join();
+    }
+}
+
+// Refill the free list up to the high watermark, one batch per frame lock hold
+// so faults keep getting through while the reclaimer runs
+void MemoryManager::reclaimerLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(reclaimMutex);
+            reclaimCV.wait(lock, [this] { return reclaimerStopping || reclaimRequested.load(); });
+            if (reclaimerStopping) {
+                return;
+            }
+            // Cleared before unlocking, so a request made during the pass wakes us again
+            reclaimRequested = false;
+        }
+        reclaimWakeups.fetch_add(1, std::memory_order_relaxed);
+        
+        auto start = std::chrono::steady_clock::now();
+        while (reclaimBatch() > 0) {
+            std::this_thread::yield();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        reclaimTimeMicros.fetch_add(static_cast<size_t>(elapsed.count()), std::memory_order_relaxed);
+    }
+}
+
+// Evict up to RECLAIM_BATCH victims chosen by the replacement policy. Returns how
+// many frames were freed, 0 once the high watermark is reached or nothing can go.
+size_t MemoryManager::reclaimBatch() {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    size_t freed = 0;
+    while (freed < RECLAIM_BATCH && freeFrameList.size() < highWatermark) {
+        // Not holding any process lock, so every victim owner is try_locked
+        bool ownersBusy = false;
+        size_t frameNumber = reclaimFrame(FrameTable::NO_OWNER, ownersBusy);
+        if (frameNumber == static_cast<size_t>(-1)) {
+            break;
+        }
+        freeFrameList.push_back(frameNumber);
+        freed++;
+    }
+    reclaimedPages.fetch_add(freed, std::memory_order_relaxed);
+    return freed;
+}
+
+void MemoryManager::setDedupScanRate(size_t pagesPerScan) {
+    stopDedupScanner();
+    
+    dedupPagesPerScan = pagesPerScan;
+    if (dedupPagesPerScan > 0) {
+        dedupStopping = false;
+        dedupThread = std::thread(&MemoryManager::dedupLoop, this);
+    }
+}
+
+void MemoryManager::stopDedupScanner() {
+    {
+        std::lock_guard<std::mutex> lock(dedupMutex);
+        dedupStopping = true;
+    }
+    dedupCV.notify_one();
+    if (dedupThread.joinable()) {
+        dedupThread.join();
+    }
+}
+
+void MemoryManager::dedupLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(dedupMutex);
+            dedupCV.wait_for(lock, std::chrono::milliseconds(DEDUP_SCAN_INTERVAL_MS), [this] { return dedupStopping; });
+            if (dedupStopping) {
+                return;
+            }
+        }
+        dedupScan();
+    }
+}
+
+// Visit the next dedupPagesPerScan frames. Owners are only try_locked, as in reclaim;
+// a frame whose owner is busy is skipped this pass. Retiring the tag keeps TLB
+// writes out while the frame is read, and the frame is retagged afterwards.
+void MemoryManager::dedupScan() {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    
+    for (size_t visited = 0; visited < dedupPagesPerScan && numFrames > 0; visited++) {
+        size_t frameNumber = dedupCursor;
+        if (++dedupCursor == numFrames) {
+            dedupCursor = 0;
+            dedupCandidates.clear();  // Drop candidates that may have changed since
+        }
+        if (!frameTable.isOccupied(frameNumber)) {
+            continue;
+        }
+        
+        std::vector<std::unique_lock<std::mutex>> ownerLocks;
+        if (!lockSharers(frameNumber, FrameTable::NO_OWNER, ownerLocks) || isHugeFrame(frameNumber)) {
+            continue;  // Owner busy, or part of a huge page that has to stay in its block
+        }
+        retireFrameTag(frameNumber);
+        dedupScannedPages.fetch_add(1, std::memory_order_relaxed);
+        
+        // Only a page that kept its contents since the last visit is worth merging;
+        // one that is still being written would be copied straight back
+        uint64_t checksum = checksumFrame(frameData(frameNumber), wordsPerFrame);
+        bool stable = checksum == frameChecksums[frameNumber];
+        frameChecksums[frameNumber] = checksum;
+        
+        if (stable && std::memcmp(frameData(frameNumber), zeroPage.data(), wordsPerFrame * sizeof(uint16_t)) == 0) {
+            mapToZeroPage(frameNumber);
+            continue;
+        }
+        
+        if (stable) {
+            auto candidate = dedupCandidates.find(checksum);
+            if (candidate != dedupCandidates.end() && candidate->second != frameNumber &&
+                frameTable.isOccupied(candidate->second) &&
+                lockSharers(candidate->second, FrameTable::NO_OWNER, ownerLocks) &&
+                !isHugeFrame(candidate->second)) {
+                size_t keptFrame = candidate->second;
+                retireFrameTag(keptFrame);
+                bool identical = std::memcmp(frameData(keptFrame), frameData(frameNumber),
+                                             wordsPerFrame * sizeof(uint16_t)) == 0;
+                if (identical) {
+                    mergeFrames(keptFrame, frameNumber);
+                }
+                frameTable.tag[keptFrame].store(nextFrameTag++);
+                if (identical) {
+                    continue;
+                }
+            }
+            dedupCandidates[checksum] = frameNumber;
+        }
+        frameTable.tag[frameNumber].store(nextFrameTag++);
+    }
+}
+
+// Move every page of duplicateFrame onto keptFrame copy-on-write and free duplicateFrame
+// (caller holds frameMutex and the locks of every page on both frames). The moved
+// pages take the kept frame's slot: it matches the shared contents unless the kept
+// frame is dirty, and then the next write-back replaces it anyway.
+void MemoryManager::mergeFrames(size_t keptFrame, size_t duplicateFrame) {
+    size_t keptSlot = mappedPages(keptFrame).front()->backingSlot;
+    for (Page* page : mappedPages(keptFrame)) {
+        page->copyOnWrite = true;
+    }
+    
+    std::vector<FrameTable::Mapping> moved = frameTable.sharers[duplicateFrame];
+    moved.push_back({ frameTable.owner[duplicateFrame], frameTable.page[duplicateFrame] });
+    for (const FrameTable::Mapping& mapping : moved) {
+        Page& page = pageTables[mapping.processId].pages[mapping.pageNumber];
+        backingStore->retainSlot(keptSlot);
+        backingStore->releaseSlot(page.backingSlot);
+        page.backingSlot = keptSlot;
+        page.frameNumber = keptFrame;
+        page.copyOnWrite = true;
+        addMapping(keptFrame, mapping.processId, mapping.pageNumber);
+    }
+    
+    if (frameTable.isShared(duplicateFrame)) {
+        sharingPages -= frameTable.sharers[duplicateFrame].size();
+        sharedFrames--;
+        frameTable.sharers[duplicateFrame].clear();
+    }
+    frameTable.speculative[duplicateFrame] = FrameTable::NOT_SPECULATIVE;
+    releaseFrame(duplicateFrame);
+    dedupMergedPages.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Unmap every page of an all-zero frame and free it; the pages read from the zero
+// page again until written (caller holds frameMutex and the locks of those pages)
+void MemoryManager::mapToZeroPage(size_t frameNumber) {
+    std::vector<FrameTable::Mapping> mappings = frameTable.sharers[frameNumber];
+    mappings.push_back({ frameTable.owner[frameNumber], frameTable.page[frameNumber] });
+    for (const FrameTable::Mapping& mapping : mappings) {
+        ProcessPageTable& table = pageTables[mapping.processId];
+        Page& page = table.pages[mapping.pageNumber];
+        backingStore->releaseSlot(page.backingSlot);
+        page.backingSlot = BackingStore::NO_SLOT;
+        page.isInMemory = false;
+        page.frameNumber = static_cast<size_t>(-1);
+        page.copyOnWrite = false;
+        table.residentPages--;
+    }
+    
+    if (frameTable.isShared(frameNumber)) {
+        sharingPages -= frameTable.sharers[frameNumber].size();
+        sharedFrames--;
+        frameTable.sharers[frameNumber].clear();
+    }
+    frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+    releaseFrame(frameNumber);
+    dedupZeroPages.fetch_add(1, std::memory_order_relaxed);
+}
+
+// The backing store synchronizes with its writer itself, so no memory lock is needed
+void MemoryManager::setWritebackQueueSize(size_t pages) {
+    backingStore->setWriteQueueCapacity(pages);
+}
+
+void MemoryManager::setCompressedPoolSize(size_t bytes) {
+    backingStore->setCompressedPoolCapacity(bytes);
+}
+
+bool MemoryManager::setAccessModel(const std::string& modelName) {
+    std::string key = modelName;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    
+    if (key == "realistic") accessModel = MemoryAccessModel::REALISTIC;
+    else if (key == "stress") accessModel = MemoryAccessModel::STRESS;
+    else return false;
+    return true;
 }
 
-// Convert virtual address to page number
-size_t MemoryManager::virtualToPageNumber(size_t virtualAddress) const {
-    return virtualAddress / PAGE_SIZE;
+std::string MemoryManager::getAccessModelName() const {
+    return accessModel == MemoryAccessModel::REALISTIC ? "REALISTIC" : "STRESS";
 }
 
-// Convert virtual address to page offset
-size_t MemoryManager::virtualToPageOffset(size_t virtualAddress) const {
-    return (virtualAddress % PAGE_SIZE) / 2;  // 2 bytes per uint16
+bool MemoryManager::setAdmissionPolicy(const std::string& policyName) {
+    std::lock_guard<std::mutex> admissionLock(admissionMutex);
+    return admissionQueue.setPolicy(policyName);
 }
 
-// Find a free frame
-size_t MemoryManager::findFreeFrame() {
-    for (size_t i = 0; i < frames.size(); i++) {
-        if (!frames[i].isOccupied) {
-            return i;
+// Requests that can never be satisfied are refused rather than left to block the queue
+bool MemoryManager::enqueueAdmission(std::shared_ptr<Screen> process, size_t memorySize) {
+    std::lock_guard<std::mutex> admissionLock(admissionMutex);
+    {
+        std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+        if (!isValidMemorySize(memorySize) || memorySize > getCommitLimit()) {
+            return false;
         }
     }
-    return static_cast<size_t>(-1);  // No free frame
+    
+    process->setStatus("WAITING");
+    admissionQueue.push(std::move(process), memorySize);
+    return true;
 }
 
-// Select victim frame using FIFO
-size_t MemoryManager::selectVictimFrame() {
-    if (loadedPagesQueue.empty()) {
-        return static_cast<size_t>(-1);
-    }
-    
-    std::pair<std::string, size_t> victimPage = loadedPagesQueue.front();
-    
-    // Find the frame containing this page
-    for (size_t i = 0; i < frames.size(); i++) {
-        if (frames[i].isOccupied && 
-            frames[i].processName == victimPage.first && 
-            frames[i].pageNumber == victimPage.second) {
-            return i;
+std::vector<std::shared_ptr<Screen>> MemoryManager::admitWaitingProcesses() {
+    std::lock_guard<std::mutex> admissionLock(admissionMutex);
+    return admissionQueue.admit([this](const PendingAdmission& entry) {
+        ProcessHandle handle = allocateMemory(entry.process->getName(), entry.memorySize);
+        if (handle == INVALID_PROCESS_HANDLE) {
+            return false;
         }
-    }
-    
-    return static_cast<size_t>(-1);
+        entry.process->setMemorySize(entry.memorySize);
+        entry.process->setMemoryHandle(handle);
+        entry.process->setStatus("READY");
+        return true;
+    });
 }
 
-// Page out a page to backing store
-void MemoryManager::pageOut(const std::string& processName, size_t pageNumber) {
-    if (processPages.find(processName) == processPages.end() || 
-        pageNumber >= processPages[processName].size()) {
+// Page out a page to backing store (caller holds frameMutex and the owner's lock)
+void MemoryManager::pageOut(uint32_t processId, size_t pageNumber) {
+    if (processId >= pageTables.size() || pageNumber >= pageTables[processId].pages.size()) {
         return;
     }
     
-    Page& page = processPages[processName][pageNumber];
+    Page& page = pageTables[processId].pages[pageNumber];
     if (!page.isInMemory) return;
+    if (page.huge) {
+        demoteHugePage(pageTables[processId], pageNumber);
+    }
     
-    // Get the current data from the frame
-    if (page.frameNumber < frames.size()) {
-        page.data = frames[page.frameNumber].data;  // Save current frame data to page
+    // Other processes still use a shared frame; only this page lets go of it
+    if (frameTable.isShared(page.frameNumber)) {
+        unmapSharedPage(processId, pageNumber);
+        return;
     }
     
-    // Write page data to backing store
-    std::ofstream file(backingStoreFile, std::ios::app);
-    if (file.is_open()) {
-        file << processName << ":" << pageNumber << ":";
-        for (size_t i = 0; i < page.data.size(); i++) {
-            file << std::hex << std::setw(4) << std::setfill('0') << page.data[i];
-            if (i < page.data.size() - 1) file << ",";
-        }
-        file << "\n";
-        file.close();
-        
-        /*std::cout << "[PAGE OUT] " << processName 
-                  << " Page:" << pageNumber 
-                  << " Size:" << page.data.size() * 2 << " bytes written to backing store" << std::endl;*/
+    retireFrameTag(page.frameNumber);
+    
+    // Only a dirty frame needs writing back. A clean one still matches its
+    // backing store slot, or is all zeros if it never had one. With a write
+    // queue the copy is handed to the background writer instead of the file.
+    if (frameTable.isDirty(page.frameNumber)) {
+        writeBackFrame(page.frameNumber);
+        dirtyEvictions.fetch_add(1, std::memory_order_relaxed);
     } else {
-        std::cout << "[ERROR] Failed to open backing store file for writing" << std::endl;
+        cleanEvictions.fetch_add(1, std::memory_order_relaxed);
     }
     
-    // Clear the frame
-    if (page.frameNumber < frames.size()) {
-        frames[page.frameNumber].isOccupied = false;
-        frames[page.frameNumber].processName.clear();
-        frames[page.frameNumber].pageNumber = static_cast<size_t>(-1);
-        frames[page.frameNumber].data.clear();
-        frames[page.frameNumber].data.resize(FRAME_SIZE / 2, 0);
-    }
+    // Free the frame
+    releaseFrame(page.frameNumber);
     
     // Mark page as not in memory
     page.isInMemory = false;
     page.frameNumber = static_cast<size_t>(-1);
+    page.copyOnWrite = false;
+    
+    ProcessPageTable& table = pageTables[processId];
+    table.residentPages--;
+    if (page.backingSlot != BackingStore::NO_SLOT) {
+        table.swappedPages++;
+        swappedPages++;
+    }
     
     incrementPagesOut();
 }
 
-// Page in a page from backing store
-void MemoryManager::pageIn(const std::string& processName, size_t pageNumber, size_t frameNumber) {
-    if (processPages.find(processName) == processPages.end() || 
-        pageNumber >= processPages[processName].size() ||
-        frameNumber >= frames.size()) {
-        return;
+// Every page mapping a frame, the owner first (caller holds frameMutex)
+std::vector<Page*> MemoryManager::mappedPages(size_t frameNumber) {
+    std::vector<Page*> pages;
+    pages.push_back(&pageTables[frameTable.owner[frameNumber]].pages[frameTable.page[frameNumber]]);
+    for (const FrameTable::Mapping& sharer : frameTable.sharers[frameNumber]) {
+        pages.push_back(&pageTables[sharer.processId].pages[sharer.pageNumber]);
+    }
+    return pages;
+}
+
+// try_lock every process mapping the frame except heldProcessId, whose lock the
+// caller already holds (caller holds frameMutex). False if any of them is busy.
+bool MemoryManager::lockSharers(size_t frameNumber, uint32_t heldProcessId, std::vector<std::unique_lock<std::mutex>>& locks) {
+    std::vector<uint32_t> owners;
+    owners.push_back(frameTable.owner[frameNumber]);
+    for (const FrameTable::Mapping& sharer : frameTable.sharers[frameNumber]) {
+        owners.push_back(sharer.processId);
+    }
+    
+    for (uint32_t owner : owners) {
+        bool alreadyLocked = owner == heldProcessId;
+        for (const auto& lock : locks) {
+            alreadyLocked = alreadyLocked || lock.mutex() == &pageTables[owner].mutex;
+        }
+        if (alreadyLocked) {
+            continue;
+        }
+        locks.emplace_back(pageTables[owner].mutex, std::try_to_lock);
+        if (!locks.back().owns_lock()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Write a dirty frame to the slot its pages share (caller holds frameMutex and the
+// locks of every page mapping it). A slot also referenced by pages elsewhere holds
+// their older copy, so the frame moves to a slot of its own.
+void MemoryManager::writeBackFrame(size_t frameNumber) {
+    std::vector<Page*> pages = mappedPages(frameNumber);
+    size_t slot = pages.front()->backingSlot;
+    if (slot == BackingStore::NO_SLOT || backingStore->getSlotReferences(slot) > pages.size()) {
+        size_t newSlot = backingStore->allocateSlot();
+        for (size_t i = 0; i < pages.size(); i++) {
+            backingStore->releaseSlot(pages[i]->backingSlot);
+            if (i > 0) {
+                backingStore->retainSlot(newSlot);
+            }
+            pages[i]->backingSlot = newSlot;
+        }
+        slot = newSlot;
+    }
+    
+    if (!backingStore->writePage(slot, frameData(frameNumber))) {
+        std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+    }
+    frameTable.dirty[frameNumber] = 0;
+}
+
+// Page out one page of a shared frame, leaving the frame with the other pages
+// (caller holds frameMutex and the lock of processId). If the frame is newer than
+// the shared slot, this page's copy goes to a slot of its own.
+void MemoryManager::unmapSharedPage(uint32_t processId, size_t pageNumber) {
+    Page& page = pageTables[processId].pages[pageNumber];
+    size_t frameNumber = page.frameNumber;
+    
+    if (frameTable.isDirty(frameNumber)) {
+        size_t slot = backingStore->allocateSlot();
+        if (!backingStore->writePage(slot, frameData(frameNumber))) {
+            std::cout << "[ERROR] Failed to write page to backing store" << std::endl;
+        }
+        backingStore->releaseSlot(page.backingSlot);
+        page.backingSlot = slot;
+        dirtyEvictions.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        cleanEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    removeMapping(frameNumber, processId, pageNumber);
+    
+    page.isInMemory = false;
+    page.frameNumber = static_cast<size_t>(-1);
+    page.copyOnWrite = false;
+    
+    ProcessPageTable& table = pageTables[processId];
+    table.residentPages--;
+    if (page.backingSlot != BackingStore::NO_SLOT) {
+        table.swappedPages++;
+        swappedPages++;
     }
     
-    Page& page = processPages[processName][pageNumber];
+    incrementPagesOut();
+}
+
+// Map one more page onto a frame copy-on-write (caller holds frameMutex and the
+// lock of processId, or tableMutex exclusively). A shared frame stops counting as
+// speculative, since its pages' readers would race to claim the one hit.
+void MemoryManager::addMapping(size_t frameNumber, uint32_t processId, size_t pageNumber) {
+    if (!frameTable.isShared(frameNumber)) {
+        sharedFrames++;
+    }
+    frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+    frameTable.sharers[frameNumber].push_back({ processId, static_cast<uint32_t>(pageNumber) });
+    sharingPages++;
+}
+
+// Take one page off a shared frame, promoting a sharer if it was the owner, and
+// retag the frame so TLB entries of the page go stale (caller holds frameMutex
+// and the lock of processId)
+void MemoryManager::removeMapping(size_t frameNumber, uint32_t processId, size_t pageNumber) {
+    std::vector<FrameTable::Mapping>& sharers = frameTable.sharers[frameNumber];
+    if (frameTable.owner[frameNumber] == processId && frameTable.page[frameNumber] == pageNumber) {
+        frameTable.owner[frameNumber] = sharers.back().processId;
+        frameTable.page[frameNumber] = sharers.back().pageNumber;
+        sharers.pop_back();
+    } else {
+        sharers.erase(std::find_if(sharers.begin(), sharers.end(), [&](const FrameTable::Mapping& sharer) {
+            return sharer.processId == processId && sharer.pageNumber == pageNumber;
+        }));
+    }
+    sharingPages--;
+    if (sharers.empty()) {
+        sharedFrames--;
+    }
     
-    // Try to read from backing store first
-    bool foundInStore = false;
-    std::ifstream file(backingStoreFile);
-    if (file.is_open()) {
-        std::string line;
-        while (std::getline(file, line)) {
-            if (line.find("ProcessName:PageNumber:Data") != std::string::npos || 
-                line.find("CSOPESY Backing Store") != std::string::npos) {
-                continue;  // Skip header lines
+    retireFrameTag(frameNumber);
+    frameTable.tag[frameNumber].store(nextFrameTag++);
+}
+
+// Give a copy-on-write page a frame of its own before it is written (caller holds
+// the lock of processId; frameMutex is taken here). If the other pages have let go
+// of the frame meanwhile, the page keeps it. False if no frame could be found.
+bool MemoryManager::breakCopyOnWrite(uint32_t processId, size_t pageNumber) {
+    Page& page = pageTables[processId].pages[pageNumber];
+    
+    while (true) {
+        {
+            std::lock_guard<std::mutex> frameLock(frameMutex);
+            if (!page.isInMemory || !frameTable.isShared(page.frameNumber)) {
+                page.copyOnWrite = false;
+                return page.isInMemory;
             }
             
-            std::istringstream iss(line);
-            std::string storedProcess, storedPageStr, dataStr;
+            bool ownersBusy = false;
+            size_t frameNumber = findFreeFrame();
+            if (frameNumber == static_cast<size_t>(-1)) {
+                frameNumber = reclaimFrame(processId, ownersBusy);
+            }
             
-            if (std::getline(iss, storedProcess, ':') &&
-                std::getline(iss, storedPageStr, ':') &&
-                std::getline(iss, dataStr)) {
-                
-                if (storedProcess == processName && 
-                    std::stoul(storedPageStr) == pageNumber) {
-                    
-                    // Parse data
-                    std::istringstream dataIss(dataStr);
-                    std::string valueStr;
-                    size_t i = 0;
-                    page.data.clear();
-                    page.data.resize(PAGE_SIZE / 2, 0);
-                    
-                    while (std::getline(dataIss, valueStr, ',') && i < page.data.size()) {
-                        try {
-                            page.data[i++] = static_cast<uint16_t>(std::stoul(valueStr, nullptr, 16));
-                        } catch (...) {
-                            page.data[i++] = 0;
-                        }
-                    }
-                    foundInStore = true;
-                    break;
+            if (frameNumber != static_cast<size_t>(-1)) {
+                if (!page.isInMemory) {
+                    // The shared frame itself was reclaimed; read the page back privately
+                    pageIn(processId, pageNumber, frameNumber);
+                    return true;
                 }
+                if (!frameTable.isShared(page.frameNumber)) {
+                    freeFrameList.push_back(frameNumber);
+                    page.copyOnWrite = false;
+                    return true;
+                }
+                
+                size_t sharedFrame = page.frameNumber;
+                std::copy(frameData(sharedFrame), frameData(sharedFrame) + wordsPerFrame, frameData(frameNumber));
+                removeMapping(sharedFrame, processId, pageNumber);
+                
+                // The page stays resident and keeps its slot reference, so only the frame changes
+                frameTable.owner[frameNumber] = processId;
+                frameTable.page[frameNumber] = static_cast<uint32_t>(pageNumber);
+                frameTable.occupied[frameNumber] = 1;
+                frameTable.dirty[frameNumber] = frameTable.dirty[sharedFrame];
+                frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+                frameTable.tag[frameNumber].store(nextFrameTag++);
+                page.frameNumber = frameNumber;
+                page.copyOnWrite = false;
+                residentPages++;
+                replacementPolicy->frameLoaded(frameNumber);
+                cowCopies.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            if (!ownersBusy) {
+                return false;  // No pages to evict
             }
         }
-        file.close();
+        
+        std::this_thread::yield();
+    }
+}
+
+// Page in a page from backing store (caller holds frameMutex and the owner's lock)
+void MemoryManager::pageIn(uint32_t processId, size_t pageNumber, size_t frameNumber) {
+    if (processId >= pageTables.size() || pageNumber >= pageTables[processId].pages.size() ||
+        frameNumber >= numFrames) {
+        return;
     }
     
-    // If not found in backing store, initialize with zeros
-    if (!foundInStore) {
-        page.data.resize(PAGE_SIZE / 2, 0);
+    Page& page = pageTables[processId].pages[pageNumber];
+    
+    // Read the page straight into the frame, or copy the zero page if it was never written back
+    uint16_t* data = frameData(frameNumber);
+    if (page.backingSlot == BackingStore::NO_SLOT) {
+        std::copy(zeroPage.begin(), zeroPage.end(), data);
+        zeroFillFaults.fetch_add(1, std::memory_order_relaxed);
+    } else if (!backingStore->readPage(page.backingSlot, data)) {
+        std::fill(data, data + wordsPerFrame, static_cast<uint16_t>(0));
     }
     
-    // Initialize frame with page data
-    frames[frameNumber].isOccupied = true;
-    frames[frameNumber].processName = processName;
-    frames[frameNumber].pageNumber = pageNumber;
-    frames[frameNumber].data = page.data;  // Copy page data to frame
+    installPage(processId, pageNumber, frameNumber);
+}
+
+// Map a frame whose contents are already loaded (caller holds frameMutex and the owner's lock)
+void MemoryManager::installPage(uint32_t processId, size_t pageNumber, size_t frameNumber) {
+    Page& page = pageTables[processId].pages[pageNumber];
+    
+    frameTable.owner[frameNumber] = processId;
+    frameTable.page[frameNumber] = static_cast<uint32_t>(pageNumber);
+    frameTable.occupied[frameNumber] = 1;
+    frameTable.dirty[frameNumber] = 0;
+    frameTable.accessed[frameNumber].store(0, std::memory_order_relaxed);
+    frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+    frameTable.tag[frameNumber].store(nextFrameTag++);
     
     // Mark page as in memory
     page.isInMemory = true;
     page.frameNumber = frameNumber;
     
-    // Add to FIFO queue for page replacement
-    loadedPagesQueue.push(std::make_pair(processName, pageNumber));
+    ProcessPageTable& table = pageTables[processId];
+    table.residentPages++;
+    residentPages++;
+    if (page.backingSlot != BackingStore::NO_SLOT) {
+        table.swappedPages--;
+        swappedPages--;
+    }
+    
+    // Let the replacement policy track the new page
+    replacementPolicy->frameLoaded(frameNumber);
     
     incrementPagesIn();
     
-    /*std::cout << "[PAGE IN] " << processName 
+    /*std::cout << "[PAGE IN] " << pageTables[processId].processName 
               << " Page:" << pageNumber 
               << " loaded into frame:" << frameNumber << std::endl;*/
 }
 
-// Handle page fault with proper FIFO replacement
-bool MemoryManager::handlePageFault(const std::string& processName, size_t virtualAddress) {
+// Grow the window while faults walk forward through the page table, shrink it otherwise,
+// then read the next window of swapped-out pages into free frames. Runs of pages in
+// consecutive backing store slots are read with a single request.
+// Caller holds frameMutex and the lock of processId.
+void MemoryManager::readahead(uint32_t processId, size_t faultPage) {
+    ProcessPageTable& table = pageTables[processId];
+    
+    bool sequential = table.lastFaultPage != static_cast<size_t>(-1) &&
+                      faultPage > table.lastFaultPage && faultPage <= table.readaheadEnd + 1;
+    if (sequential) {
+        table.readaheadWindow = std::min(std::max<size_t>(table.readaheadWindow * 2, 1), maxReadahead);
+    } else {
+        table.readaheadWindow /= 2;
+    }
+    table.lastFaultPage = faultPage;
+    table.readaheadEnd = faultPage + table.readaheadWindow;
+    
+    std::vector<size_t> pageNumbers;
+    std::vector<size_t> frames;
+    std::vector<uint16_t*> destinations;
+    size_t lastPage = std::min(table.readaheadEnd, table.pages.size() - 1);
+    for (size_t pageNumber = faultPage + 1; pageNumber <= lastPage && !freeFrameList.empty(); pageNumber++) {
+        const Page& page = table.pages[pageNumber];
+        if (page.isInMemory || page.isZeroMapped() || page.huge) {
+            continue;  // Resident, served by the zero page until it is written, or loaded whole on its own fault
+        }
+        size_t frameNumber = findFreeFrame();
+        pageNumbers.push_back(pageNumber);
+        frames.push_back(frameNumber);
+        destinations.push_back(frameData(frameNumber));
+        
+        // Install once the page that ends this run of consecutive slots is known
+        bool runEnds = pageNumber == lastPage || freeFrameList.empty() ||
+                       table.pages[pageNumber + 1].isInMemory || table.pages[pageNumber + 1].huge ||
+                       table.pages[pageNumber + 1].backingSlot != page.backingSlot + 1;
+        if (!runEnds) {
+            continue;
+        }
+        
+        size_t firstSlot = table.pages[pageNumbers.front()].backingSlot;
+        bool loaded = backingStore->readPages(firstSlot, pageNumbers.size(), destinations.data());
+        for (size_t i = 0; i < pageNumbers.size(); i++) {
+            if (!loaded) {
+                freeFrameList.push_back(frames[i]);
+                continue;
+            }
+            installPage(processId, pageNumbers[i], frames[i]);
+            frameTable.speculative[frames[i]] = FrameTable::LOADED_BY_READAHEAD;
+            readaheadPages.fetch_add(1, std::memory_order_relaxed);
+        }
+        pageNumbers.clear();
+        frames.clear();
+        destinations.clear();
+    }
+}
+
+// First reference to a page that was loaded ahead of use (caller holds the owner's lock)
+void MemoryManager::noteReference(size_t frameNumber) {
+    uint8_t loadedBy = frameTable.speculative[frameNumber];
+    if (loadedBy == FrameTable::NOT_SPECULATIVE) {
+        return;
+    }
+    frameTable.speculative[frameNumber] = FrameTable::NOT_SPECULATIVE;
+    if (loadedBy == FrameTable::LOADED_BY_READAHEAD) {
+        readaheadHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        prefetchHits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Handle page fault, evicting a victim chosen by the replacement policy.
+// The caller holds the lock of processId; frameMutex is taken here.
+bool MemoryManager::handlePageFault(uint32_t processId, size_t virtualAddress) {
     incrementPageFaults();
     
     size_t pageNumber = virtualToPageNumber(virtualAddress);
     
     // Check if process and page exist
-    if (processPages.find(processName) == processPages.end() || 
-        pageNumber >= processPages[processName].size()) {
+    if (processId >= pageTables.size() || pageNumber >= pageTables[processId].pages.size()) {
         return false;
     }
     
-    Page& page = processPages[processName][pageNumber];
+    ProcessPageTable& table = pageTables[processId];
+    Page& page = table.pages[pageNumber];
     
     // If page is already in memory, no need to do anything
     if (page.isInMemory) {
         return true;
     }
+    table.windowFaults++;
     
-    // Find a free frame
-    size_t frameNumber = findFreeFrame();
-    
-    // If no free frame, use FIFO page replacement
-    if (frameNumber == static_cast<size_t>(-1)) {
-        if (loadedPagesQueue.empty()) {
-            return false;  // No pages to evict
-        }
-        
-        // Get the oldest page from FIFO queue and remove it
-        std::pair<std::string, size_t> victimPage = loadedPagesQueue.front();
-        loadedPagesQueue.pop();
-        
-        // Find the frame containing this page
-        frameNumber = static_cast<size_t>(-1);
-        for (size_t i = 0; i < frames.size(); i++) {
-            if (frames[i].isOccupied && 
-                frames[i].processName == victimPage.first && 
-                frames[i].pageNumber == victimPage.second) {
-                frameNumber = i;
-                break;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> frameLock(frameMutex);
+            
+            // A dense region comes in as one huge page, then readahead carries on past it
+            if (hugePagePages > 0 && faultHugePage(processId, pageNumber)) {
+                if (freeFrameList.size() < lowWatermark) {
+                    wakeReclaimer();
+                }
+                if (maxReadahead > 0) {
+                    readahead(processId, pageNumber - pageNumber % hugePagePages + hugePagePages - 1);
+                }
+                return true;
+            }
+            
+            // A process at its quota replaces its own pages. Otherwise find a free
+            // frame, or ask the replacement policy for a victim.
+            bool ownersBusy = false;
+            size_t frameNumber = static_cast<size_t>(-1);
+            if (workingSetWindow > 0 && table.residentPages >= table.frameQuota.load(std::memory_order_relaxed)) {
+                frameNumber = replaceLocalPage(processId);
+                if (frameNumber != static_cast<size_t>(-1)) {
+                    localReplacements.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            bool directReclaim = false;
+            if (frameNumber == static_cast<size_t>(-1)) {
+                frameNumber = findFreeFrame();
+                directReclaim = frameNumber == static_cast<size_t>(-1);
+            }
+            if (directReclaim) {
+                frameNumber = reclaimFrame(processId, ownersBusy);
+            }
+            if (freeFrameList.size() < lowWatermark) {
+                wakeReclaimer();
+            }
+            
+            if (frameNumber != static_cast<size_t>(-1)) {
+                if (directReclaim) {
+                    directReclaims.fetch_add(1, std::memory_order_relaxed);
+                }
+                
+                // Page in the required page, then any pages the access pattern predicts
+                pageIn(processId, pageNumber, frameNumber);
+                if (maxReadahead > 0) {
+                    readahead(processId, pageNumber);
+                }
+                return true;
+            }
+            if (!ownersBusy) {
+                return false;  // No pages to evict
             }
         }
         
-        if (frameNumber == static_cast<size_t>(-1)) {
-            return false;  // Could not find the victim frame
-        }
-        
-        // Page out the victim
-        pageOut(frames[frameNumber].processName, frames[frameNumber].pageNumber);
-        
-        // Mark the victim page as not in memory
-        if (processPages.find(victimPage.first) != processPages.end() && 
-            victimPage.second < processPages[victimPage.first].size()) {
-            processPages[victimPage.first][victimPage.second].isInMemory = false;
-            processPages[victimPage.first][victimPage.second].frameNumber = static_cast<size_t>(-1);
-        }
+        // Every resident page belongs to a process that is busy right now; let them finish
+        std::this_thread::yield();
+    }
+}
+
+// A handle is the process id; it stays valid until the process is deallocated
+bool MemoryManager::isValidHandle(ProcessHandle handle) const {
+    return handle >= 0 && static_cast<size_t>(handle) < pageTables.size() &&
+           pageTables[static_cast<size_t>(handle)].inUse;
+}
+
+// TLB hit path, taking no lock. Pin the frame, then confirm it still holds the load
+// the entry was filled from; if it was evicted or reloaded since, report a miss.
+bool MemoryManager::tlbAccess(TLB& tlb, uint32_t processId, size_t virtualAddress, bool isWrite, uint16_t& value) {
+    const TLBEntry* entry = tlb.lookup(processId, virtualToPageNumber(virtualAddress));
+    if (!entry || (isWrite && !entry->writable)) {
+        return false;
+    }
+    
+    size_t frameNumber = entry->frameNumber;
+    frameTable.pins[frameNumber].fetch_add(1);
+    if (frameTable.tag[frameNumber].load() != entry->frameTag) {
+        frameTable.pins[frameNumber].fetch_sub(1);
+        return false;
     }
     
-    // Page in the required page
-    pageIn(processName, pageNumber, frameNumber);
+    uint16_t* data = frameData(frameNumber);
+    size_t pageOffset = virtualToPageOffset(virtualAddress);
+    if (isWrite) {
+        data[pageOffset] = value;
+        frameTable.dirty[frameNumber] = 1;
+    } else {
+        value = data[pageOffset];
+    }
+    frameTable.accessed[frameNumber].store(1, std::memory_order_relaxed);
+    replacementPolicy->frameReferenced(frameNumber);
     
+    frameTable.pins[frameNumber].fetch_sub(1);
     return true;
 }
 
-// Read memory with page fault handling
-uint16_t MemoryManager::readMemory(const std::string& processName, size_t virtualAddress) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    
-    if (!isValidVirtualAddress(processName, virtualAddress)) {
+TLB* MemoryManager::getTLB(int coreId) const {
+    if (coreId < 0 || static_cast<size_t>(coreId) >= tlbs.size()) {
+        return nullptr;
+    }
+    return tlbs[static_cast<size_t>(coreId)].get();
+}
+
+// Read memory with page fault handling (caller holds tableMutex shared and the process lock).
+// The translation is cached in tlb when one is given.
+uint16_t MemoryManager::readWord(uint32_t processId, size_t virtualAddress, TLB* tlb) {
+    if (!isValidVirtualAddress(pageTables[processId], virtualAddress)) {
         return 0;  // Invalid address
     }
     
     size_t pageNumber = virtualToPageNumber(virtualAddress);
     size_t pageOffset = virtualToPageOffset(virtualAddress);
     
-    // Check if page is in memory
-    if (processPages.find(processName) == processPages.end() || 
-        pageNumber >= processPages[processName].size()) {
-        return 0;
-    }
+    Page& page = pageTables[processId].pages[pageNumber];
     
-    Page& page = processPages[processName][pageNumber];
+    // A page that was never written reads as zeros; it only gets a frame on its first write
+    if (page.isZeroMapped()) {
+        zeroPageReads.fetch_add(1, std::memory_order_relaxed);
+        return zeroPage[pageOffset];
+    }
     
     if (!page.isInMemory) {
         // Page fault - bring page into memory
-        if (!handlePageFault(processName, virtualAddress)) {
+        if (!handlePageFault(processId, virtualAddress)) {
             return 0;  // Failed to handle page fault
         }
     }
     
     // Read from frame
-    if (page.frameNumber < frames.size() && 
-        pageOffset < frames[page.frameNumber].data.size()) {
-        return frames[page.frameNumber].data[pageOffset];
+    if (page.frameNumber < numFrames && pageOffset < wordsPerFrame) {
+        replacementPolicy->frameReferenced(page.frameNumber);
+        noteReference(page.frameNumber);
+        frameTable.accessed[page.frameNumber].store(1, std::memory_order_relaxed);
+        if (tlb) {
+            tlb->insert(processId, pageNumber, page.frameNumber, frameTable.tag[page.frameNumber].load(),
+                        !page.copyOnWrite);
+        }
+        return frameData(page.frameNumber)[pageOffset];
     }
     
     return 0;
 }
 
-// Write memory with page fault handling
-void MemoryManager::writeMemory(const std::string& processName, size_t virtualAddress, uint16_t value) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    
-    if (!isValidVirtualAddress(processName, virtualAddress)) {
+// Write memory with page fault handling (caller holds tableMutex shared and the process lock).
+// The translation is cached in tlb when one is given.
+void MemoryManager::writeWord(uint32_t processId, size_t virtualAddress, uint16_t value, TLB* tlb) {
+    if (!isValidVirtualAddress(pageTables[processId], virtualAddress)) {
         return;  // Invalid address
     }
     
     size_t pageNumber = virtualToPageNumber(virtualAddress);
     size_t pageOffset = virtualToPageOffset(virtualAddress);
     
-    // Check if page is in memory
-    if (processPages.find(processName) == processPages.end() || 
-        pageNumber >= processPages[processName].size()) {
-        return;
-    }
-    
-    Page& page = processPages[processName][pageNumber];
+    Page& page = pageTables[processId].pages[pageNumber];
     
     if (!page.isInMemory) {
         // Page fault - bring page into memory
-        if (!handlePageFault(processName, virtualAddress)) {
+        if (!handlePageFault(processId, virtualAddress)) {
             return;  // Failed to handle page fault
         }
     }
     
+    // A frame shared with another process is copied before the first write
+    if (page.copyOnWrite && !breakCopyOnWrite(processId, pageNumber)) {
+        return;
+    }
+    
     // Write to frame
-    if (page.frameNumber < frames.size() && 
-        pageOffset < frames[page.frameNumber].data.size()) {
-        frames[page.frameNumber].data[pageOffset] = value;
-        // Also update the page data
-        page.data[pageOffset] = value;
+    if (page.frameNumber < numFrames && pageOffset < wordsPerFrame) {
+        replacementPolicy->frameReferenced(page.frameNumber);
+        noteReference(page.frameNumber);
+        frameData(page.frameNumber)[pageOffset] = value;
+        frameTable.dirty[page.frameNumber] = 1;
+        frameTable.accessed[page.frameNumber].store(1, std::memory_order_relaxed);
+        if (tlb) {
+            tlb->insert(processId, pageNumber, page.frameNumber, frameTable.tag[page.frameNumber].load());
+        }
     }
 }
 
-// Validate virtual address
-bool MemoryManager::isValidVirtualAddress(const std::string& processName, size_t virtualAddress) {
-    if (processPages.find(processName) == processPages.end()) {
-        return false;
+// A TLB hit on the caller's core takes no lock. Otherwise accesses only lock the
+// page table of their own process, so resident-page accesses by different
+// processes never wait on each other.
+uint16_t MemoryManager::readMemory(ProcessHandle handle, size_t virtualAddress, int coreId) {
+    TLB* tlb = getTLB(coreId);
+    if (tlb && handle >= 0) {
+        uint16_t value = 0;
+        if (tlbAccess(*tlb, static_cast<uint32_t>(handle), virtualAddress, false, value)) {
+            tlb->recordHit();
+            return value;
+        }
+        tlb->recordMiss();
     }
     
-    // Calculate the total memory allocated to this process
-    size_t totalProcessMemory = processPages[processName].size() * PAGE_SIZE;
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
-    // Check if virtual address is within the process's allocated memory space
-    if (virtualAddress >= totalProcessMemory) {
-        return false;
+    if (!isValidHandle(handle)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
+    return readWord(static_cast<uint32_t>(handle), virtualAddress, tlb);
+}
+
+// Reference a page the way an ordinary read would: fault only if it is not resident.
+// False if the handle or address is invalid.
+bool MemoryManager::touchPage(ProcessHandle handle, size_t virtualAddress, int coreId) {
+    TLB* tlb = getTLB(coreId);
+    if (tlb && handle >= 0) {
+        uint16_t value = 0;
+        if (tlbAccess(*tlb, static_cast<uint32_t>(handle), virtualAddress, false, value)) {
+            tlb->recordHit();
+            return true;
+        }
+        tlb->recordMiss();
     }
     
-    size_t pageNumber = virtualToPageNumber(virtualAddress);
-    size_t pageOffset = virtualToPageOffset(virtualAddress);
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
-    if (pageNumber >= processPages[processName].size()) {
+    if (!isValidHandle(handle) || !isValidVirtualAddress(pageTables[handle], virtualAddress)) {
         return false;
     }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
+    readWord(static_cast<uint32_t>(handle), virtualAddress, tlb);
+    return true;
+}
+
+void MemoryManager::writeMemory(ProcessHandle handle, size_t virtualAddress, uint16_t value, int coreId) {
+    TLB* tlb = getTLB(coreId);
+    if (tlb && handle >= 0) {
+        if (tlbAccess(*tlb, static_cast<uint32_t>(handle), virtualAddress, true, value)) {
+            tlb->recordHit();
+            return;
+        }
+        tlb->recordMiss();
+    }
     
-    if (pageOffset >= PAGE_SIZE / 2) {  // 16 uint16 values per page
-        return false;
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    if (!isValidHandle(handle)) {
+        return;
     }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
+    writeWord(static_cast<uint32_t>(handle), virtualAddress, value, tlb);
+}
+
+// Name-based access, kept for callers that do not hold a handle
+uint16_t MemoryManager::readMemory(const std::string& processName, size_t virtualAddress) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
-    return true;
+    auto it = processIds.find(processName);
+    if (it == processIds.end()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> processLock(pageTables[it->second].mutex);
+    return readWord(it->second, virtualAddress);
+}
+
+void MemoryManager::writeMemory(const std::string& processName, size_t virtualAddress, uint16_t value) {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    auto it = processIds.find(processName);
+    if (it == processIds.end()) {
+        return;
+    }
+    std::lock_guard<std::mutex> processLock(pageTables[it->second].mutex);
+    writeWord(it->second, virtualAddress, value);
+}
+
+ProcessHandle MemoryManager::getProcessHandle(const std::string& processName) const {
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    auto it = processIds.find(processName);
+    return it != processIds.end() ? static_cast<ProcessHandle>(it->second) : INVALID_PROCESS_HANDLE;
+}
+
+// Validate virtual address
+bool MemoryManager::isValidVirtualAddress(const ProcessPageTable& table, size_t virtualAddress) const {
+    // Calculate the total memory allocated to this process
+    size_t totalProcessMemory = table.pages.size() * PAGE_SIZE;
+    
+    // Within the process's allocated memory space, every address falls on one of its
+    // pages at an offset inside the page, so the callers' translation needs no checks
+    return virtualAddress < totalProcessMemory;
 }
 
 bool MemoryManager::isValidMemorySize(size_t size) {
@@ -445,107 +1961,192 @@ bool MemoryManager::isValidMemorySize(size_t size) {
     return (size & (size - 1)) == 0;
 }
 
-bool MemoryManager::allocateMemory(const std::string& processName, size_t size) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+ProcessHandle MemoryManager::allocateMemory(const std::string& processName, size_t size) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
 
     // Validate memory size
     if (!isValidMemorySize(size)) {
-        return false;
+        return INVALID_PROCESS_HANDLE;
     }
 
-    // Check if requested size exceeds total system memory
-    if (size > totalMemory) {
+    // Check if requested size exceeds physical memory plus swap
+    if (size > getCommitLimit()) {
         //std::cout << "[MEMORY MANAGER] Process " << processName 
         //          << " requests " << size << " bytes, but total system memory is only " 
         //          << totalMemory << " bytes. Allocation failed." << std::endl;
-        return false; // Cannot allocate more memory than total system memory
+        return INVALID_PROCESS_HANDLE; // Cannot allocate more memory than total system memory
     }
 
     // Check if process already has memory allocated
-    if (processPages.find(processName) != processPages.end()) {
-        return false; // Process already has memory
+    if (processIds.find(processName) != processIds.end()) {
+        return INVALID_PROCESS_HANDLE; // Process already has memory
     }
 
     // Check if there's enough total memory available
-    size_t currentUsedMemory = 0;
-    for (const auto& entry : processPages) {
-        currentUsedMemory += entry.second.size() * PAGE_SIZE;
-    }
+    size_t currentUsedMemory = getUsedMemory();
     
-    if (currentUsedMemory + size > totalMemory) {
+    if (currentUsedMemory + size > getCommitLimit()) {
         //std::cout << "[MEMORY MANAGER] Process " << processName 
         //          << " requests " << size << " bytes, but only " 
         //          << (totalMemory - currentUsedMemory) << " bytes available. Allocation failed." << std::endl;
-        return false; // Not enough memory available
+        return INVALID_PROCESS_HANDLE; // Not enough memory available
     }
 
     // Create virtual pages for demand paging
-    createProcessPages(processName, size);
+    return static_cast<ProcessHandle>(createProcessPages(processName, size));
+}
 
-    return true;
+ProcessHandle MemoryManager::reserveAddressSpace(const std::string& processName, size_t size) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    if (!isValidMemorySize(size) || size > MAX_RESERVATION_SIZE ||
+        processIds.find(processName) != processIds.end()) {
+        return INVALID_PROCESS_HANDLE;
+    }
+    
+    // Nothing is committed: frames and slots are taken as the process touches pages
+    return static_cast<ProcessHandle>(createProcessPages(processName, size, true));
 }
 
 void MemoryManager::deallocateMemory(const std::string& processName) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    std::lock_guard<std::mutex> frameLock(frameMutex);
 
     // Clean up process pages and frames
-    if (processPages.find(processName) != processPages.end()) {
-        // Page out and free any frames occupied by this process
-        for (auto& frame : frames) {
-            if (frame.processName == processName) {
-                // Page out before freeing
-                pageOut(processName, frame.pageNumber);
-                frame.isOccupied = false;
-                frame.processName.clear();
-                frame.pageNumber = static_cast<size_t>(-1);
-                frame.data.clear();
-                frame.data.resize(FRAME_SIZE / 2, 0);
+    auto it = processIds.find(processName);
+    if (it != processIds.end()) {
+        // Free the resident frames and backing store slots of this process.
+        // The contents are discarded, so nothing is written back; releasing a frame
+        // takes it out of the replacement policy as well.
+        // A frame shared copy-on-write stays with the other processes mapping it.
+        ProcessPageTable& table = pageTables[it->second];
+        uint32_t processId = it->second;
+        table.pages.forEachPage([&](size_t pageNumber, const Page& page) {
+            if (page.isInMemory && frameTable.isShared(page.frameNumber)) {
+                removeMapping(page.frameNumber, processId, pageNumber);
+            } else if (page.isInMemory) {
+                releaseFrame(page.frameNumber);
             }
+            backingStore->releaseSlot(page.backingSlot);
+        });
+        
+        // Remove process pages; the id is reused by the next allocation.
+        // releaseFrame already took the resident pages off the totals.
+        allocatedMemory -= table.committedMemory;
+        swappedPages -= table.swappedPages.load();
+        if (table.swappedOut) {
+            swappedOutMemory -= table.committedMemory;
+            table.swappedOut = false;
+            table.residentSet.clear();
+        }
+        table.residentPages = 0;
+        table.swappedPages = 0;
+        table.inUse = false;
+        releaseWorkingSet(static_cast<ProcessHandle>(it->second));
+        table.processName.clear();
+        table.pages.clear();
+        table.committedMemory = 0;
+        freeProcessIds.push_back(it->second);
+        processIds.erase(it);
+    }
+}
+
+ProcessHandle MemoryManager::forkProcess(ProcessHandle parent, const std::string& childName) {
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    if (!isValidHandle(parent) || processIds.find(childName) != processIds.end()) {
+        return INVALID_PROCESS_HANDLE;
+    }
+    
+    // The child is committed like the parent, since either side may write every page
+    const ProcessPageTable& origin = pageTables[parent];
+    size_t size = origin.pages.size() * PAGE_SIZE;
+    bool sparse = origin.committedMemory == 0 && size > 0;
+    if (getUsedMemory() + origin.committedMemory > getCommitLimit()) {
+        return INVALID_PROCESS_HANDLE;
+    }
+    
+    // Holding tableMutex exclusively keeps every process lock free, so only the
+    // frame table needs locking
+    std::lock_guard<std::mutex> frameLock(frameMutex);
+    uint32_t childId = createProcessPages(childName, size, sparse);
+    ProcessPageTable& parentTable = pageTables[parent];
+    ProcessPageTable& childTable = pageTables[childId];
+    childTable.frameQuota = parentTable.frameQuota.load();
+    
+    // Only leaves the parent has touched are walked, and the child gets a page only
+    // where the parent's holds something
+    parentTable.pages.forEachPage([&](size_t pageNumber, Page& source) {
+        if (source.huge) {
+            demoteHugePage(parentTable, pageNumber);  // Its frames are about to be shared
+        }
+        if (!source.isInMemory && source.backingSlot == BackingStore::NO_SLOT) {
+            return;
         }
+        Page& copy = childTable.pages[pageNumber];
         
-        // Clean up FIFO queue - remove entries for this process
-        std::queue<std::pair<std::string, size_t>> newQueue;
-        while (!loadedPagesQueue.empty()) {
-            auto entry = loadedPagesQueue.front();
-            loadedPagesQueue.pop();
-            if (entry.first != processName) {
-                newQueue.push(entry);
-            }
+        if (source.backingSlot != BackingStore::NO_SLOT) {
+            backingStore->retainSlot(source.backingSlot);
+            copy.backingSlot = source.backingSlot;
         }
-        loadedPagesQueue = newQueue;
         
-        // Remove process pages
-        processPages.erase(processName);
-    }
+        if (source.isInMemory) {
+            // Both pages map the frame read-only until one of them writes. Retagging
+            // drops the parent's writable TLB entries.
+            size_t frameNumber = source.frameNumber;
+            addMapping(frameNumber, childId, pageNumber);
+            retireFrameTag(frameNumber);
+            frameTable.tag[frameNumber].store(nextFrameTag++);
+            
+            source.copyOnWrite = true;
+            copy.copyOnWrite = true;
+            copy.isInMemory = true;
+            copy.frameNumber = frameNumber;
+            childTable.residentPages++;
+        } else if (copy.backingSlot != BackingStore::NO_SLOT) {
+            childTable.swappedPages++;
+            swappedPages++;
+        }
+    });
+    
+    cowForks.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<ProcessHandle>(childId);
 }
 
 MemoryManager::MemorySnapshot MemoryManager::getMemorySnapshot() const {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
 
     MemorySnapshot snapshot;
     snapshot.totalMemory = totalMemory;
+    snapshot.swapCapacity = swapCapacity;
     
-    // Calculate used memory
-    size_t used = 0;
-    size_t activeProcs = 0;
-    for (const auto& entry : processPages) {
-        size_t processMemory = entry.second.size() * PAGE_SIZE;
-        used += processMemory;
-        activeProcs++;
-        snapshot.processMemory.emplace_back(entry.first, processMemory);
+    // Used memory comes from the running total; the per-process list is still built here
+    size_t used = getUsedMemory();
+    for (const auto& entry : processIds) {
+        snapshot.processMemory.emplace_back(entry.first, pageTables[entry.second].pages.size() * PAGE_SIZE);
     }
     
     snapshot.usedMemory = used;
-    snapshot.availableMemory = totalMemory - used;
-    snapshot.activeProcesses = activeProcs;
+    snapshot.availableMemory = getCommitLimit() - used;
+    snapshot.activeProcesses = processIds.size();
+    snapshot.residentPages = residentPages;
+    snapshot.swappedPages = swappedPages;
     snapshot.inactiveProcesses = 0;
     snapshot.fragmentationCount = 0;
-    snapshot.largestFreeBlock = totalMemory - used;
+    snapshot.largestFreeBlock = getCommitLimit() - used;
 
     // Add demand paging statistics
     snapshot.pagesIn = pagesIn;
     snapshot.pagesOut = pagesOut;
     snapshot.pageFaults = pageFaults;
+    snapshot.dirtyEvictions = dirtyEvictions;
+    snapshot.cleanEvictions = cleanEvictions;
+    snapshot.tlbHits = 0;
+    snapshot.tlbMisses = 0;
+    for (const auto& tlb : tlbs) {
+        snapshot.tlbHits += tlb->getHits();
+        snapshot.tlbMisses += tlb->getMisses();
+    }
     snapshot.idleCpuTicks = idleCpuTicks;
     snapshot.activeCpuTicks = activeCpuTicks;
     snapshot.totalCpuTicks = totalCpuTicks;
@@ -555,15 +2156,15 @@ MemoryManager::MemorySnapshot MemoryManager::getMemorySnapshot() const {
 
 // Legacy compatibility methods
 bool MemoryManager::allocateMemory(std::shared_ptr<Screen> process, int memorySize) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+    std::unique_lock<std::shared_mutex> tableLock(tableMutex);
     
     // Check if memory size is valid (power of 2, between 64 and 65536)
     if (memorySize < 64 || memorySize > 65536 || (memorySize & (memorySize - 1)) != 0) {
         return false;
     }
     
-    // Check if requested size exceeds total system memory
-    if (static_cast<size_t>(memorySize) > totalMemory) {
+    // Check if requested size exceeds physical memory plus swap
+    if (static_cast<size_t>(memorySize) > getCommitLimit()) {
         //std::cout << "[MEMORY MANAGER] Process " << process->getName() 
         //          << " requests " << memorySize << " bytes, but total system memory is only " 
         //          << totalMemory << " bytes. Allocation failed." << std::endl;
@@ -573,17 +2174,14 @@ bool MemoryManager::allocateMemory(std::shared_ptr<Screen> process, int memorySi
     std::string processName = process->getName();
     
     // Check if process already has memory allocated
-    if (processPages.find(processName) != processPages.end()) {
+    if (processIds.find(processName) != processIds.end()) {
         return false; // Process already has memory
     }
     
     // Check if there's enough total memory available
-    size_t currentUsedMemory = 0;
-    for (const auto& entry : processPages) {
-        currentUsedMemory += entry.second.size() * PAGE_SIZE;
-    }
+    size_t currentUsedMemory = getUsedMemory();
     
-    if (currentUsedMemory + static_cast<size_t>(memorySize) > totalMemory) {
+    if (currentUsedMemory + static_cast<size_t>(memorySize) > getCommitLimit()) {
         //std::cout << "[MEMORY MANAGER] Process " << processName 
         //          << " requests " << memorySize << " bytes, but only " 
         //          << (totalMemory - currentUsedMemory) << " bytes available. Allocation failed." << std::endl;
@@ -591,64 +2189,55 @@ bool MemoryManager::allocateMemory(std::shared_ptr<Screen> process, int memorySi
     }
     
     // Create virtual pages for demand paging
-    createProcessPages(processName, static_cast<size_t>(memorySize));
+    uint32_t processId = createProcessPages(processName, static_cast<size_t>(memorySize));
     
-    // Update memory size for the process
+    // Update memory size and handle for the process
     process->setMemorySize(memorySize);
-    
-    // Update legacy page tables for compatibility
-    int pagesNeeded = (memorySize + memoryPerFrame_ - 1) / memoryPerFrame_;
-    std::vector<Page> pageTable;
-    pageTable.reserve(pagesNeeded);
-    for (int i = 0; i < pagesNeeded; ++i) {
-        pageTable.emplace_back(i, processName);
-    }
-    pageTables_[process] = std::move(pageTable);
+    process->setMemoryHandle(static_cast<ProcessHandle>(processId));
     
     return true;
 }
 
 void MemoryManager::deallocateMemory(std::shared_ptr<Screen> process) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    
-    std::string processName = process->getName();
-    
-    // Clean up new system
-    deallocateMemory(processName);
-    
-    // Clean up legacy system
-    auto it = pageTables_.find(process);
-    if (it != pageTables_.end()) {
-        pageTables_.erase(it);
-    }
+    // The process page table is keyed by name (takes the locks itself)
+    deallocateMemory(process->getName());
+    process->setMemoryHandle(INVALID_PROCESS_HANDLE);
 }
 
-bool MemoryManager::accessMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, bool isWrite) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+bool MemoryManager::accessMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, bool isWrite, int coreId) {
+    ProcessHandle handle = process->getMemoryHandle();
+    if (accessModel.load(std::memory_order_relaxed) == MemoryAccessModel::REALISTIC) {
+        return touchPage(handle, static_cast<size_t>(virtualAddress), coreId);
+    }
     
-    std::string processName = process->getName();
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
     // For Test Case 4: Force maximum paging activity
-    if (processPages.find(processName) == processPages.end()) {
+    if (!isValidHandle(handle)) {
         return false;
     }
     
+    uint32_t processId = static_cast<uint32_t>(handle);
+    std::lock_guard<std::mutex> processLock(pageTables[processId].mutex);
     size_t pageNumber = virtualToPageNumber(static_cast<size_t>(virtualAddress));
     
     // Check if page number is valid for this process
-    if (pageNumber >= processPages[processName].size()) {
+    if (pageNumber >= pageTables[processId].pages.size()) {
         return false;
     }
     
-    Page& page = processPages[processName][pageNumber];
+    Page& page = pageTables[processId].pages[pageNumber];
     
     // Always trigger page fault to maximize paging activity for Test Case 4
     if (!page.isInMemory) {
-        return handlePageFault(processName, static_cast<size_t>(virtualAddress));
+        return handlePageFault(processId, static_cast<size_t>(virtualAddress));
     } else {
         // Force page eviction and reload to simulate extreme memory pressure
-        pageOut(processName, pageNumber);
-        return handlePageFault(processName, static_cast<size_t>(virtualAddress));
+        {
+            std::lock_guard<std::mutex> frameLock(frameMutex);
+            pageOut(processId, pageNumber);
+        }
+        return handlePageFault(processId, static_cast<size_t>(virtualAddress));
     }
 }
 
@@ -658,18 +2247,20 @@ bool MemoryManager::readMemory(std::shared_ptr<Screen> process, uint32_t virtual
     //           << " at address: 0x" << std::hex << virtualAddress << std::dec << std::endl;
     // ===== END DEBUG SECTION =====
     
-    std::string processName = process->getName();
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
     // Validate that the process has allocated memory
-    if (processPages.find(processName) == processPages.end()) {
+    ProcessHandle handle = process->getMemoryHandle();
+    if (!isValidHandle(handle)) {
         // ===== DEBUG SECTION - Uncomment for troubleshooting =====
-        // std::cout << "[DEBUG] Process " << processName << " has no allocated memory" << std::endl;
+        // std::cout << "[DEBUG] Process " << process->getName() << " has no allocated memory" << std::endl;
         // ===== END DEBUG SECTION =====
         return false;
     }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
     
     // Use new system for actual memory access (handles page faults automatically)
-    value = readMemory(processName, static_cast<size_t>(virtualAddress));
+    value = readWord(static_cast<uint32_t>(handle), static_cast<size_t>(virtualAddress));
     
     // ===== DEBUG SECTION - Uncomment for troubleshooting =====
     // std::cout << "[DEBUG] Read value: " << value << " from address: 0x" 
@@ -686,18 +2277,20 @@ bool MemoryManager::writeMemory(std::shared_ptr<Screen> process, uint32_t virtua
     //           << " with value: " << value << std::endl;
     // ===== END DEBUG SECTION =====
     
-    std::string processName = process->getName();
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
     // Validate that the process has allocated memory
-    if (processPages.find(processName) == processPages.end()) {
+    ProcessHandle handle = process->getMemoryHandle();
+    if (!isValidHandle(handle)) {
         // ===== DEBUG SECTION - Uncomment for troubleshooting =====
-        // std::cout << "[DEBUG] Process " << processName << " has no allocated memory" << std::endl;
+        // std::cout << "[DEBUG] Process " << process->getName() << " has no allocated memory" << std::endl;
         // ===== END DEBUG SECTION =====
         return false;
     }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
     
     // Use new system for actual memory access (handles page faults automatically)
-    writeMemory(processName, static_cast<size_t>(virtualAddress), value);
+    writeWord(static_cast<uint32_t>(handle), static_cast<size_t>(virtualAddress), value);
     
     // ===== DEBUG SECTION - Uncomment for troubleshooting =====
     // std::cout << "[DEBUG] Successfully wrote value: " << value << " to address: 0x" 
@@ -708,24 +2301,34 @@ bool MemoryManager::writeMemory(std::shared_ptr<Screen> process, uint32_t virtua
 }
 
 bool MemoryManager::handlePageFault(std::shared_ptr<Screen> process, int pageNumber) {
-    stats_.numPagedIn++;
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
-    std::string processName = process->getName();
+    ProcessHandle handle = process->getMemoryHandle();
+    if (!isValidHandle(handle)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> processLock(pageTables[handle].mutex);
     
     // Use new system for page fault handling
     size_t virtualAddress = static_cast<size_t>(pageNumber) * PAGE_SIZE;
-    return handlePageFault(processName, virtualAddress);
+    return handlePageFault(static_cast<uint32_t>(handle), virtualAddress);
 }
 
 // Legacy helper methods
 int MemoryManager::findVictimFrame() {
     // Use new system
+    std::lock_guard<std::mutex> frameLock(frameMutex);
     size_t victim = selectVictimFrame();
-    return (victim == static_cast<size_t>(-1)) ? -1 : static_cast<int>(victim);
+    if (victim == static_cast<size_t>(-1)) {
+        return -1;
+    }
+    // Only a peek: nothing is evicted, so the policy keeps the frame
+    replacementPolicy->frameSkipped(victim);
+    return static_cast<int>(victim);
 }
 
 void MemoryManager::pageOut(int frameId) {
-    if (frameId < 0 || static_cast<size_t>(frameId) >= frames_.size()) {
+    if (frameId < 0 || static_cast<size_t>(frameId) >= numFrames) {
         return;
     }
     
@@ -746,50 +2349,108 @@ std::vector<uint8_t> MemoryManager::readFromBackingStore(std::shared_ptr<Screen>
     return std::vector<uint8_t>(memoryPerFrame_, 0);
 }
 
+// Every figure is a running counter, so this does not depend on the process count
 MemoryStats MemoryManager::getStats() const {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    
-    // Calculate current memory usage from processPages
-    size_t currentUsedMemory = 0;
-    for (const auto& entry : processPages) {
-        currentUsedMemory += entry.second.size() * PAGE_SIZE;
-    }
+    size_t currentUsedMemory = getUsedMemory();
+    size_t usedFrames = residentPages.load(std::memory_order_relaxed);
     
     // Update stats from new system
     MemoryStats updatedStats = stats_;
     updatedStats.totalMemory = static_cast<int>(totalMemory);
     updatedStats.usedMemory = static_cast<int>(currentUsedMemory);
-    updatedStats.freeMemory = static_cast<int>(totalMemory - currentUsedMemory);
+    updatedStats.freeMemory = static_cast<int>(getCommitLimit() - currentUsedMemory);
+    updatedStats.swapMemory = static_cast<int>(swapCapacity);
+    updatedStats.admissionQueueLength = static_cast<int>(admissionQueue.getLength());
+    updatedStats.avgAdmissionLatencyMs = admissionQueue.getAverageLatencyMs();
+    updatedStats.writebackQueueDepth = static_cast<int>(backingStore->getQueuedWrites());
+    updatedStats.writebackLagMs = backingStore->getWriterLagMs();
+    updatedStats.writebackQueueReads = static_cast<int>(backingStore->getQueueReads());
+    const CompressedPool& pool = backingStore->getCompressedPool();
+    updatedStats.compressedPoolPages = static_cast<int>(pool.getStoredPages());
+    updatedStats.compressedPoolBytes = static_cast<int>(pool.getStoredBytes());
+    updatedStats.compressionRatio = pool.getCompressionRatio();
+    updatedStats.compressedPoolHits = static_cast<int>(pool.getHits());
+    updatedStats.compressedPoolMisses = static_cast<int>(backingStore->getQueueReads() + backingStore->getFileReads());
+    updatedStats.compressedPoolSpills = static_cast<int>(pool.getSpills());
+    updatedStats.compressedPoolRejects = static_cast<int>(pool.getRejects());
+    updatedStats.reclaimWakeups = static_cast<int>(reclaimWakeups);
+    updatedStats.reclaimedPages = static_cast<int>(reclaimedPages);
+    updatedStats.reclaimTimeMs = static_cast<double>(reclaimTimeMicros) / 1000.0;
+    updatedStats.directReclaims = static_cast<int>(directReclaims);
+    updatedStats.readaheadPages = static_cast<int>(readaheadPages);
+    updatedStats.readaheadHits = static_cast<int>(readaheadHits);
+    updatedStats.readaheadWaste = static_cast<int>(readaheadWaste);
+    updatedStats.numPageFaults = static_cast<int>(pageFaults);
+    updatedStats.prefetchRequests = static_cast<int>(prefetchRequests);
+    updatedStats.prefetchedPages = static_cast<int>(prefetchedPages);
+    updatedStats.prefetchHits = static_cast<int>(prefetchHits);
+    updatedStats.prefetchWaste = static_cast<int>(prefetchWaste);
+    updatedStats.prefetchDropped = static_cast<int>(prefetchDropped);
+    updatedStats.zeroPageReads = static_cast<int>(zeroPageReads);
+    updatedStats.zeroFillFaults = static_cast<int>(zeroFillFaults);
+    updatedStats.cowForks = static_cast<int>(cowForks);
+    updatedStats.cowCopies = static_cast<int>(cowCopies);
+    updatedStats.sharedFrames = static_cast<int>(sharedFrames);
+    updatedStats.sharingPages = static_cast<int>(sharingPages);
+    updatedStats.dedupScannedPages = static_cast<int>(dedupScannedPages);
+    updatedStats.dedupMergedPages = static_cast<int>(dedupMergedPages);
+    updatedStats.dedupZeroPages = static_cast<int>(dedupZeroPages);
+    updatedStats.localReplacements = static_cast<int>(localReplacements);
+    updatedStats.heldBackProcesses = static_cast<int>(heldBackProcesses);
+    updatedStats.processSwapOuts = static_cast<int>(processSwapOuts);
+    updatedStats.processSwapIns = static_cast<int>(processSwapIns);
+    updatedStats.bulkPagesOut = static_cast<int>(bulkPagesOut);
+    updatedStats.bulkPagesIn = static_cast<int>(bulkPagesIn);
+    updatedStats.hugePromotions = static_cast<int>(hugePromotions);
+    updatedStats.hugeDemotions = static_cast<int>(hugeDemotions);
+    updatedStats.hugePageFaults = static_cast<int>(hugePageFaults);
+    updatedStats.hugePageEvictions = static_cast<int>(hugePageEvictions);
+    updatedStats.usedFrames = static_cast<int>(usedFrames);
+    updatedStats.freeFrames = static_cast<int>(numFrames - usedFrames);
     updatedStats.numPagedIn = static_cast<int>(pagesIn);
     updatedStats.numPagedOut = static_cast<int>(pagesOut);
+    updatedStats.numDirtyEvictions = static_cast<int>(dirtyEvictions);
+    updatedStats.numCleanEvictions = static_cast<int>(cleanEvictions);
+    size_t tlbHits = 0;
+    size_t tlbMisses = 0;
+    for (const auto& tlb : tlbs) {
+        tlbHits += tlb->getHits();
+        tlbMisses += tlb->getMisses();
+    }
+    updatedStats.tlbHits = static_cast<int>(tlbHits);
+    updatedStats.tlbMisses = static_cast<int>(tlbMisses);
     updatedStats.idleCpuTicks = static_cast<int>(idleCpuTicks);
     updatedStats.activeCpuTicks = static_cast<int>(activeCpuTicks);
     updatedStats.totalCpuTicks = static_cast<int>(totalCpuTicks);
+    {
+        std::lock_guard<std::mutex> frameLock(frameMutex);
+        updatedStats.replacementPolicy = replacementPolicy->getName();
+    }
+    updatedStats.accessModel = getAccessModelName();
     
     return updatedStats;
 }
 
+// Called by the scheduler every tick; only touches atomic counters unless an aging tick is due
 void MemoryManager::updateCpuTicks(bool isActive) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    totalCpuTicks++;
+    size_t ticks = totalCpuTicks.fetch_add(1, std::memory_order_relaxed) + 1;
     if (isActive) {
-        activeCpuTicks++;
+        activeCpuTicks.fetch_add(1, std::memory_order_relaxed);
     } else {
-        idleCpuTicks++;
+        idleCpuTicks.fetch_add(1, std::memory_order_relaxed);
     }
     
-    // Update legacy stats
-    stats_.totalCpuTicks++;
-    if (isActive) {
-        stats_.activeCpuTicks++;
-    } else {
-        stats_.idleCpuTicks++;
+    // Let the replacement policy age its reference history. A tick that finds the
+    // frame lock busy is skipped rather than stalling the scheduler.
+    if (ticks % REPLACEMENT_TICK_INTERVAL == 0) {
+        std::unique_lock<std::mutex> frameLock(frameMutex, std::try_to_lock);
+        if (frameLock.owns_lock()) {
+            replacementPolicy->tick();
+        }
     }
 }
 
 void MemoryManager::printMemoryStatus() const {
-    std::lock_guard<std::mutex> lock(memoryMutex);
-    
     std::cout << "-------------------------------------------" << std::endl;
     std::cout << "| PROCESS-SMI V01.00 Driver Version: 01.00|" << std::endl;
     std::cout << "-------------------------------------------" << std::endl;
@@ -797,24 +2458,29 @@ void MemoryManager::printMemoryStatus() const {
     // Calculate CPU utilization
     double cpuUtil = 0.0;
     if (totalCpuTicks > 0) {
-        cpuUtil = (static_cast<double>(activeCpuTicks) / totalCpuTicks) * 100.0;
+        cpuUtil = (static_cast<double>(activeCpuTicks) / static_cast<double>(totalCpuTicks)) * 100.0;
     }
     
     std::cout << "CPU-Util: " << std::fixed << std::setprecision(0) << cpuUtil << "%" << std::endl;
     
     // Calculate memory usage
-    size_t usedMemory = 0;
-    for (const auto& entry : processPages) {
-        usedMemory += entry.second.size() * PAGE_SIZE;
-    }
+    size_t usedMemory = getUsedMemory();
     
-    std::cout << "Memory Usage: " << usedMemory << " bytes/ " << totalMemory << " bytes" << std::endl;
+    // Usage is measured against the commit limit, so it stays within 100% under overcommit
+    size_t commitLimit = getCommitLimit();
+    std::cout << "Memory Usage: " << usedMemory << " bytes/ " << commitLimit << " bytes" << std::endl;
     
     double memUtil = 0.0;
-    if (totalMemory > 0) {
-        memUtil = (static_cast<double>(usedMemory) / totalMemory) * 100.0;
+    if (commitLimit > 0) {
+        memUtil = (static_cast<double>(usedMemory) / commitLimit) * 100.0;
     }
     std::cout << "Memory Util: " << std::fixed << std::setprecision(0) << memUtil << "%" << std::endl;
+    
+    // Frames the sharing saves: every page on a shared frame beyond the first
+    size_t saved = sharingPages.load(std::memory_order_relaxed);
+    std::cout << "Merged Pages: " << dedupMergedPages.load(std::memory_order_relaxed)
+              << " (" << dedupZeroPages.load(std::memory_order_relaxed) << " to zero page)" << std::endl;
+    std::cout << "Shared Pages: " << saved << " (" << saved * FRAME_SIZE << " bytes saved)" << std::endl;
     std::cout << std::endl;
     std::cout << "===========================================" << std::endl;
     std::cout << "Running processes and memory usage:" << std::endl;
@@ -822,14 +2488,24 @@ void MemoryManager::printMemoryStatus() const {
 }
 
 void MemoryManager::printProcessMemoryUsage() const {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
     
-    for (const auto& entry : processPages) {
+    for (const auto& entry : processIds) {
         const std::string& processName = entry.first;
-        const std::vector<Page>& pages = entry.second;
+        const ProcessPageTable& table = pageTables[entry.second];
+        const PageTable& pages = table.pages;
         
         size_t memoryUsed = pages.size() * PAGE_SIZE;
-        std::cout << processName << " " << memoryUsed << " bytes" << std::endl;
+        std::cout << processName << " " << memoryUsed << " bytes";
+        if (table.committedMemory == 0 && pages.size() > 0) {
+            std::cout << " reserved (" << pages.getLevels() << "-level table, "
+                      << pages.getFootprintBytes() / 1024 << " KB)";
+        }
+        if (workingSetWindow > 0) {
+            std::cout << "  WS: " << table.frameQuota.load(std::memory_order_relaxed) << " pages"
+                      << "  Faults: " << table.faultRate.load(std::memory_order_relaxed) << "/1000 instr";
+        }
+        std::cout << std::endl;
     }
     
     std::cout << "-------------------------------------------" << std::endl;
@@ -840,16 +2516,40 @@ void MemoryManager::cleanupBackingStore() {
 }
 
 // Force memory access for instruction execution (Test Case 6 optimization)
-bool MemoryManager::simulateInstructionMemoryAccess(const std::string& processName) {
-    std::lock_guard<std::mutex> lock(memoryMutex);
+bool MemoryManager::simulateInstructionMemoryAccess(ProcessHandle handle, int coreId) {
+    // Each instruction advances the process's virtual time for working-set tracking
+    if (workingSetWindow > 0) {
+        std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+        if (isValidHandle(handle)) {
+            ProcessPageTable& table = pageTables[handle];
+            std::lock_guard<std::mutex> processLock(table.mutex);
+            if (++table.instructions - table.windowStart >= workingSetWindow) {
+                updateWorkingSet(table);
+            }
+        }
+    }
     
-    if (processPages.find(processName) == processPages.end()) {
+    // Realistic model: fetching from the instruction and symbol table pages only
+    // faults when one of them has been evicted
+    if (accessModel.load(std::memory_order_relaxed) == MemoryAccessModel::REALISTIC) {
+        bool touched = touchPage(handle, 0, coreId);
+        if (touched) {
+            touchPage(handle, PAGE_SIZE, coreId);
+        }
+        return touched;
+    }
+    
+    std::shared_lock<std::shared_mutex> tableLock(tableMutex);
+    
+    if (!isValidHandle(handle)) {
         return false;
     }
     
     // For Test Case 6: Simulate extreme memory pressure by forcing page faults
     // Access multiple pages to trigger maximum paging activity
-    const auto& pages = processPages[processName];
+    uint32_t processId = static_cast<uint32_t>(handle);
+    std::lock_guard<std::mutex> processLock(pageTables[processId].mutex);
+    const auto& pages = pageTables[processId].pages;
     
     // Force access to instruction page (page 0) and symbol table page
     for (size_t pageNum = 0; pageNum < std::min(pages.size(), static_cast<size_t>(2)); pageNum++) {
@@ -858,26 +2558,34 @@ bool MemoryManager::simulateInstructionMemoryAccess(const std::string& processNa
         // Check if page is in memory
         if (pageNum < pages.size() && !pages[pageNum].isInMemory) {
             // Trigger page fault
-            handlePageFault(processName, virtualAddress);
+            handlePageFault(processId, virtualAddress);
         } else if (pageNum < pages.size() && pages[pageNum].isInMemory) {
             // For extreme memory pressure simulation: force page eviction and reload
             // This simulates the scenario where memory is so constrained that even
             // recently accessed pages get evicted immediately
-            const_cast<Page&>(pages[pageNum]).isInMemory = false;
-            handlePageFault(processName, virtualAddress);
+            {
+                std::lock_guard<std::mutex> frameLock(frameMutex);
+                pageOut(processId, pageNum);
+            }
+            handlePageFault(processId, virtualAddress);
         }
     }
     
     return true;
 }
 
+bool MemoryManager::simulateInstructionMemoryAccess(const std::string& processName) {
+    return simulateInstructionMemoryAccess(getProcessHandle(processName));
+}
+
 // Legacy address translation methods
 int MemoryManager::getPageNumber(uint32_t virtualAddress) const {
-    return static_cast<int>(virtualAddress / PAGE_SIZE);
+    return static_cast<int>(virtualToPageNumber(virtualAddress));
 }
 
 int MemoryManager::getOffset(uint32_t virtualAddress) const {
-    return static_cast<int>(virtualAddress % PAGE_SIZE);
+    size_t offset = pageShift != NO_PAGE_SHIFT ? virtualAddress & pageOffsetMask : virtualAddress % PAGE_SIZE;
+    return static_cast<int>(offset);
 }
 
 uint32_t MemoryManager::getPhysicalAddress(int frameId, int offset) const {
@@ -4,42 +4,139 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <fstream>
 #include <string>
 #include <memory>
 #include <queue>
+#include <deque>
+#include <new>
+#include <thread>
+#include <condition_variable>
 #include <cstdint>
 
+#include "BackingStore.h"
+#include "ReplacementPolicy.h"
+#include "AdmissionQueue.h"
+#include "TLB.h"
+#include "PageTable.h"
+#include "ProcessHandle.h"
+
 // Forward declaration
 class Screen;
 
+// How the scheduler's per-instruction memory accesses behave.
+// REALISTIC faults only on pages that are not resident; STRESS evicts and
+// reloads the touched pages on every instruction to maximize paging activity.
+enum class MemoryAccessModel { REALISTIC, STRESS };
+
 // Constants for demand paging - will be set from config
 // static const size_t PAGE_SIZE = 32;  // Will be set dynamically from config
 // static const size_t FRAME_SIZE = 32; // Will be set dynamically from config
 
-struct Frame {
-    size_t frameId;
-    bool isOccupied;
-    std::string processName;
-    size_t pageNumber;
-    std::vector<uint16_t> data;  // Actual frame data
+// Frame metadata kept as a struct-of-arrays beside the physical memory arena.
+// Together the owner/page columns are the inverted page table (frame -> owner/page).
+// owner/page/occupied change under the frame lock plus the owner's lock; dirty is
+// set by the owner on writes, so it lives in its own column.
+// tag and pins let TLB hits use a frame without any lock: a hit pins the frame and
+// then checks that the tag still matches its cached entry, while a frame is only
+// retired after its tag is cleared and no pins are left.
+// A frame shared copy-on-write lists its other pages in sharers; they change under
+// the frame lock plus the lock of the process being added or removed.
+struct FrameTable {
+    static constexpr uint32_t NO_OWNER = static_cast<uint32_t>(-1);
+    
+    struct Mapping {
+        uint32_t processId;
+        uint32_t pageNumber;
+    };
+    
+    // Values of the speculative column
+    static constexpr uint8_t NOT_SPECULATIVE = 0;
+    static constexpr uint8_t LOADED_BY_READAHEAD = 1;
+    static constexpr uint8_t LOADED_BY_PREFETCH = 2;
     
-    Frame(size_t id, size_t frameSize = 256) : frameId(id), isOccupied(false), pageNumber(static_cast<size_t>(-1)) {
-        data.resize(frameSize / 2, 0);  // uint16 values per frame
+    std::vector<uint32_t> owner;     // Process id of the resident page
+    std::vector<uint32_t> page;      // Page number of the resident page
+    std::vector<uint8_t> occupied;
+    std::vector<uint8_t> dirty;      // Written since it was paged in; only dirty pages are written back
+    std::vector<uint8_t> speculative;  // Loaded ahead of use and not referenced yet
+    std::vector<std::vector<Mapping>> sharers;  // Pages mapping the frame besides owner/page
+    std::unique_ptr<std::atomic<uint64_t>[]> tag;   // Unique per page load, 0 while retired
+    std::unique_ptr<std::atomic<uint32_t>[]> pins;  // TLB hits currently using the frame
+    // Used since it was loaded. Every page mapping a shared frame reads it under its
+    // own lock only, so this is set without the frame lock.
+    std::unique_ptr<std::atomic<uint8_t>[]> accessed;
+    
+    void resize(size_t numFrames) {
+        owner.assign(numFrames, NO_OWNER);
+        page.assign(numFrames, 0);
+        occupied.assign(numFrames, 0);
+        dirty.assign(numFrames, 0);
+        speculative.assign(numFrames, NOT_SPECULATIVE);
+        sharers.assign(numFrames, {});
+        tag.reset(new std::atomic<uint64_t>[numFrames]);
+        pins.reset(new std::atomic<uint32_t>[numFrames]);
+        accessed.reset(new std::atomic<uint8_t>[numFrames]);
+        for (size_t i = 0; i < numFrames; i++) {
+            tag[i].store(0, std::memory_order_relaxed);
+            pins[i].store(0, std::memory_order_relaxed);
+            accessed[i].store(0, std::memory_order_relaxed);
+        }
     }
+    bool isOccupied(size_t frameNumber) const { return occupied[frameNumber] != 0; }
+    bool isDirty(size_t frameNumber) const { return dirty[frameNumber] != 0; }
+    bool isShared(size_t frameNumber) const { return !sharers[frameNumber].empty(); }
 };
 
-struct Page {
-    size_t pageNumber;
+// Page table of one process. Processes live in a dense table indexed by process id.
+// The mutex guards the pages of this process only. The page counts are kept up to
+// date by the paging paths so status queries never walk the pages.
+// committedMemory is what the process is charged against the commit limit: its
+// whole size, or nothing for a sparse reservation whose pages are made on use.
+struct ProcessPageTable {
     std::string processName;
-    size_t frameNumber;
-    bool isInMemory;
-    std::vector<uint16_t> data;  // Page data when not in memory
+    bool inUse = false;
+    PageTable pages;
+    size_t committedMemory = 0;
+    std::mutex mutex;
+    std::atomic<size_t> residentPages{0};   // Pages currently in a frame
+    std::atomic<size_t> swappedPages{0};    // Pages held only in the backing store
+    
+    // Readahead state, updated by this process's faults
+    size_t lastFaultPage = static_cast<size_t>(-1);
+    size_t readaheadEnd = 0;                 // Last page the previous fault covered
+    size_t readaheadWindow = 0;              // Pages to read after the next sequential fault
+    
+    // Prefetch state. generation changes whenever the id is reused, so requests
+    // queued for an earlier process are recognised and dropped.
+    uint32_t generation = 0;
+    size_t prefetchesQueued = 0;             // Requests waiting for the prefetcher
     
-    Page(size_t pageNum, const std::string& procName, size_t pageSize = 256) 
-        : pageNumber(pageNum), processName(procName), frameNumber(static_cast<size_t>(-1)), isInMemory(false) {
-        data.resize(pageSize / 2, 0);  // uint16 values per page
+    // Working-set state. Virtual time is the instructions the process has run; at
+    // the end of every window the fault rate over it adjusts frameQuota. The
+    // counters change under this process's lock; the atomics are read without it.
+    size_t instructions = 0;
+    size_t windowStart = 0;                  // instructions when the current window began
+    size_t windowFaults = 0;                 // Faults taken in the current window
+    size_t localHand = 0;                    // Next page considered for local replacement
+    std::atomic<size_t> frameQuota{0};       // Frames kept before the process replaces its own pages
+    std::atomic<size_t> faultRate{0};        // Faults per 1000 instructions over the last window
+    
+    // Whole-process swapping. residentSet lists the pages that were resident when
+    // the process was swapped out, to be brought back together on swap-in.
+    bool swappedOut = false;
+    std::vector<size_t> residentSet;
+};
+
+// Releases the physical memory arena allocated with cache-line alignment
+struct AlignedArenaDeleter {
+    static constexpr size_t ALIGNMENT = 64;
+    void operator()(uint16_t* arena) const {
+        ::operator delete[](arena, std::align_val_t(ALIGNMENT));
     }
 };
 
@@ -52,13 +149,78 @@ struct MemoryStats {
     int freeFrames;
     int numPagedIn;
     int numPagedOut;
+    int numDirtyEvictions;
+    int numCleanEvictions;
+    int tlbHits;
+    int tlbMisses;
+    int swapMemory;
+    int admissionQueueLength;
+    double avgAdmissionLatencyMs;
+    int writebackQueueDepth;
+    double writebackLagMs;
+    int writebackQueueReads;
+    int compressedPoolPages;
+    int compressedPoolBytes;
+    double compressionRatio;
+    int compressedPoolHits;
+    int compressedPoolMisses;
+    int compressedPoolSpills;
+    int compressedPoolRejects;
+    int reclaimWakeups;
+    int reclaimedPages;
+    double reclaimTimeMs;
+    int directReclaims;
+    int readaheadPages;
+    int readaheadHits;
+    int readaheadWaste;
+    int numPageFaults;
+    int prefetchRequests;
+    int prefetchedPages;
+    int prefetchHits;
+    int prefetchWaste;
+    int prefetchDropped;
+    int zeroPageReads;
+    int zeroFillFaults;
+    int cowForks;
+    int cowCopies;
+    int sharedFrames;
+    int sharingPages;
+    int dedupScannedPages;
+    int dedupMergedPages;
+    int dedupZeroPages;
+    int localReplacements;
+    int heldBackProcesses;
+    int processSwapOuts;
+    int processSwapIns;
+    int bulkPagesOut;
+    int bulkPagesIn;
+    int hugePromotions;
+    int hugeDemotions;
+    int hugePageFaults;
+    int hugePageEvictions;
     int idleCpuTicks;
     int activeCpuTicks;
     int totalCpuTicks;
+    std::string replacementPolicy;
+    std::string accessModel;
     
     MemoryStats() : totalMemory(0), usedMemory(0), freeMemory(0), 
                    totalFrames(0), usedFrames(0), freeFrames(0),
-                   numPagedIn(0), numPagedOut(0), idleCpuTicks(0),
+                   numPagedIn(0), numPagedOut(0), numDirtyEvictions(0),
+                   numCleanEvictions(0), tlbHits(0), tlbMisses(0), swapMemory(0),
+                   admissionQueueLength(0), avgAdmissionLatencyMs(0.0),
+                   writebackQueueDepth(0), writebackLagMs(0.0), writebackQueueReads(0),
+                   compressedPoolPages(0), compressedPoolBytes(0), compressionRatio(0.0),
+                   compressedPoolHits(0), compressedPoolMisses(0), compressedPoolSpills(0), compressedPoolRejects(0),
+                   reclaimWakeups(0), reclaimedPages(0), reclaimTimeMs(0.0), directReclaims(0),
+                   readaheadPages(0), readaheadHits(0), readaheadWaste(0),
+                   numPageFaults(0), prefetchRequests(0), prefetchedPages(0), prefetchHits(0), prefetchWaste(0),
+                   prefetchDropped(0), zeroPageReads(0), zeroFillFaults(0),
+                   cowForks(0), cowCopies(0), sharedFrames(0), sharingPages(0),
+                   dedupScannedPages(0), dedupMergedPages(0), dedupZeroPages(0),
+                   localReplacements(0), heldBackProcesses(0),
+                   processSwapOuts(0), processSwapIns(0), bulkPagesOut(0), bulkPagesIn(0),
+                   hugePromotions(0), hugeDemotions(0), hugePageFaults(0), hugePageEvictions(0), idleCpuTicks(0),
                    activeCpuTicks(0), totalCpuTicks(0) {}
 };
 
@@ -68,48 +230,244 @@ private:
     size_t PAGE_SIZE;
     size_t FRAME_SIZE;
     
+    // Address translation. For a power-of-two page size, the usual case, page numbers
+    // and word offsets take a shift and a mask worked out once at construction; any
+    // other size leaves pageShift at NO_PAGE_SHIFT and falls back to division.
+    static const size_t NO_PAGE_SHIFT = static_cast<size_t>(-1);
+    size_t pageShift = NO_PAGE_SHIFT;
+    size_t pageOffsetMask = 0;               // PAGE_SIZE - 1 when pageShift is set
+    
     // Core data structures for demand paging
-    std::vector<Frame> frames;
-    std::map<std::string, std::vector<Page>> processPages;
-    std::queue<std::pair<std::string, size_t>> loadedPagesQueue;  // FIFO queue for page replacement
+    std::unique_ptr<uint16_t[], AlignedArenaDeleter> physicalMemory;  // All frames, back to back
+    size_t wordsPerFrame;                                    // uint16 values per frame
+    std::vector<uint16_t> zeroPage;                          // Shared read-only contents of every zero-mapped page
+    FrameTable frameTable;
+    std::deque<ProcessPageTable> pageTables;                 // Indexed by process id; grows without moving entries
+    std::map<std::string, uint32_t> processIds;              // Process name -> process id
+    std::vector<uint32_t> freeProcessIds;                    // Ids of deallocated processes, reused first
+    std::vector<size_t> freeFrameList;                       // Unoccupied frames, popped from the back
+    std::unique_ptr<ReplacementPolicy> replacementPolicy;    // Chooses victims when no frame is free
+    uint64_t nextFrameTag = 1;                               // Next page load tag (frameMutex)
+    std::vector<std::unique_ptr<TLB>> tlbs;                  // One per CPU core, indexed by core id
+    
+    // Cores with an id at or above this bypass the TLB
+    static const size_t MAX_TLB_CORES = 128;
     
     // Memory configuration
     size_t totalMemory;
     size_t numFrames;
+    size_t swapCapacity = 0;                                 // Overcommit allowance on top of physical memory
     std::string backingStoreFile;
+    std::unique_ptr<BackingStore> backingStore;
     
     // Statistics tracking
-    size_t pagesIn = 0;
-    size_t pagesOut = 0;
-    size_t pageFaults = 0;
-    size_t idleCpuTicks = 0;
-    size_t activeCpuTicks = 0;
-    size_t totalCpuTicks = 0;
+    std::atomic<size_t> pagesIn{0};
+    std::atomic<size_t> pagesOut{0};
+    std::atomic<size_t> pageFaults{0};
+    std::atomic<size_t> dirtyEvictions{0};   // Evictions that wrote the page back
+    std::atomic<size_t> cleanEvictions{0};   // Evictions dropped without I/O
+    std::atomic<size_t> zeroPageReads{0};    // Reads served by the zero page, without a frame
+    std::atomic<size_t> zeroFillFaults{0};   // Faults that gave a zero-mapped page its own frame
+    std::atomic<size_t> cowForks{0};         // Processes created by forkProcess
+    std::atomic<size_t> cowCopies{0};        // Shared frames copied on a write
+    std::atomic<size_t> sharedFrames{0};     // Frames mapped by more than one page
+    std::atomic<size_t> sharingPages{0};     // Pages mapping a shared frame beyond its first, i.e. frames saved
+    
+    // Running totals, updated by allocation, paging and teardown
+    std::atomic<size_t> allocatedMemory{0};  // Virtual memory handed out to processes
+    std::atomic<size_t> residentPages{0};    // Occupied frames
+    std::atomic<size_t> swappedPages{0};     // Pages held only in the backing store
+    std::atomic<size_t> idleCpuTicks{0};
+    std::atomic<size_t> activeCpuTicks{0};
+    std::atomic<size_t> totalCpuTicks{0};
+    
+    // Replacement policies that age their history do so every this many CPU ticks
+    static const size_t REPLACEMENT_TICK_INTERVAL = 64;
+    
+    // Thread safety. Lock order: tableMutex, then a process mutex, then frameMutex.
+    // tableMutex is shared by every memory access and taken exclusively only to add
+    // or remove processes; frameMutex guards the free list, frame table, replacement
+    // policy and backing store. A fault holding frameMutex only try_locks the owner
+    // of a victim frame, so it never waits on another process.
+    mutable std::shared_mutex tableMutex;
+    mutable std::mutex frameMutex;
+    
+    std::atomic<MemoryAccessModel> accessModel{ MemoryAccessModel::STRESS };
+    
+    // Background reclaimer. A fault that leaves fewer than lowWatermark free frames
+    // wakes it, and it evicts in batches until highWatermark frames are free.
+    // reclaimMutex only guards the wakeup; it is never held with the memory locks.
+    static const size_t RECLAIM_BATCH = 8;                   // Evictions per frame lock hold
+    size_t lowWatermark = 0;                                 // Free frames; 0 disables the reclaimer
+    size_t highWatermark = 0;
+    std::thread reclaimerThread;
+    std::mutex reclaimMutex;
+    std::condition_variable reclaimCV;
+    std::atomic<bool> reclaimRequested{ false };
+    bool reclaimerStopping = false;
+    std::atomic<size_t> reclaimWakeups{ 0 };
+    std::atomic<size_t> reclaimedPages{ 0 };
+    std::atomic<size_t> reclaimTimeMicros{ 0 };
+    std::atomic<size_t> directReclaims{ 0 };                // Faults that had to evict a page themselves
+    
+    // Adaptive readahead. The window of a process doubles on sequential faults up
+    // to maxReadahead pages and halves on random ones. Pages are only read ahead
+    // into free frames and only if they are in the backing store.
+    size_t maxReadahead = 0;                                 // 0 disables readahead
+    std::atomic<size_t> readaheadPages{ 0 };                 // Pages brought in ahead of a fault
+    std::atomic<size_t> readaheadHits{ 0 };                  // ... that were referenced afterwards
+    std::atomic<size_t> readaheadWaste{ 0 };                 // ... that were evicted unreferenced
+    
+    // Prefetcher thread, fed by the instruction lookahead in Screen. Each process may
+    // have at most prefetchBudget requests waiting. prefetchMutex guards the queue
+    // and the per-process request state; it is taken after a process lock.
+    struct PrefetchRequest {
+        uint32_t processId;
+        uint32_t generation;
+        size_t pageNumber;
+    };
+    size_t prefetchBudget = 0;                               // 0 disables prefetching
+    std::deque<PrefetchRequest> prefetchQueue;
+    std::thread prefetcherThread;
+    std::mutex prefetchMutex;
+    std::condition_variable prefetchCV;
+    bool prefetcherStopping = false;
+    std::atomic<size_t> prefetchRequests{ 0 };               // Pages queued for prefetch
+    std::atomic<size_t> prefetchedPages{ 0 };                // Pages the prefetcher loaded
+    std::atomic<size_t> prefetchHits{ 0 };                   // ... that were referenced afterwards
+    std::atomic<size_t> prefetchWaste{ 0 };                  // ... that were evicted unreferenced
+    std::atomic<size_t> prefetchDropped{ 0 };                // Requests refused by the budget
     
-    // Thread safety
-    mutable std::mutex memoryMutex;
+    // Page deduplication scanner. Every DEDUP_SCAN_INTERVAL_MS it checksums the next
+    // dedupPagesPerScan frames under the frame lock. A frame whose checksum has not
+    // changed since its previous visit is merged copy-on-write into an earlier frame
+    // with the same contents, or handed back to the zero page if it is all zeros.
+    // The cursor, checksums and candidates are guarded by frameMutex.
+    static const int DEDUP_SCAN_INTERVAL_MS = 50;
+    size_t dedupPagesPerScan = 0;                            // 0 disables the scanner
+    std::thread dedupThread;
+    std::mutex dedupMutex;
+    std::condition_variable dedupCV;
+    bool dedupStopping = false;
+    size_t dedupCursor = 0;                                  // Next frame to visit
+    std::vector<uint64_t> frameChecksums;                    // Checksum at each frame's last visit
+    std::unordered_map<uint64_t, size_t> dedupCandidates;    // Checksum -> stable frame, reset every full pass
+    std::atomic<size_t> dedupScannedPages{ 0 };
+    std::atomic<size_t> dedupMergedPages{ 0 };               // Frames freed by merging into an identical one
+    std::atomic<size_t> dedupZeroPages{ 0 };                 // Frames freed because they only held zeros
+    
+    // Working-set load control (page-fault frequency). Every workingSetWindow
+    // instructions a process faulting more than PFF_HIGH times per 1000 gets a larger
+    // frame quota, and one faulting less than PFF_LOW gives a frame back. A process
+    // at its quota replaces its own pages instead of taking frames from others.
+    // The scheduler only runs a process while the quotas of everything running fit
+    // in physical memory. workingSetMutex guards runningProcesses and is taken last.
+    static const size_t PFF_HIGH = 100;
+    static const size_t PFF_LOW = 20;
+    static const size_t MIN_FRAME_QUOTA = 2;                // Instruction and symbol table pages
+    size_t workingSetWindow = 0;                             // 0 disables quotas and load control
+    std::mutex workingSetMutex;
+    std::vector<uint32_t> runningProcesses;                  // Holding a working-set reservation
+    std::atomic<size_t> localReplacements{ 0 };              // Faults served by evicting the process's own page
+    std::atomic<size_t> heldBackProcesses{ 0 };              // Reservations refused for lack of frames
+    
+    // Medium-term swapping. While the pages of the processes not swapped out exceed
+    // physical memory, the scheduler swaps out processes it preempts: their dirty
+    // pages are written as one run of fresh slots and every private frame is freed.
+    // Swap-in reads the recorded resident set back in runs of consecutive slots.
+    bool processSwapping = false;
+    std::atomic<size_t> swappedOutMemory{ 0 };               // Virtual memory of swapped-out processes
+    std::atomic<size_t> processSwapOuts{ 0 };
+    std::atomic<size_t> processSwapIns{ 0 };
+    std::atomic<size_t> bulkPagesOut{ 0 };                   // Pages freed by whole-process swap-outs
+    std::atomic<size_t> bulkPagesIn{ 0 };                    // Pages loaded by whole-process swap-ins
+    
+    // Huge pages. A region of hugePagePages pages, aligned in the address space, is
+    // promoted when a fault finds at least half of it resident: the region moves into
+    // an aligned block of as many frames, and from then on it faults in, is evicted
+    // and is written back (as one run of fresh slots) as a unit. An eviction that
+    // finds less than half the region used since it was loaded demotes it instead.
+    // Anything that moves a single page of a huge page in or out demotes it first, so
+    // the pages of a huge page are either all in their block or all swapped out.
+    size_t hugePagePages = 0;                                // 0 disables huge pages
+    std::atomic<size_t> hugePromotions{ 0 };
+    std::atomic<size_t> hugeDemotions{ 0 };
+    std::atomic<size_t> hugePageFaults{ 0 };                 // Swapped-out huge pages faulted back in whole
+    std::atomic<size_t> hugePageEvictions{ 0 };
+    
+    // Processes waiting for memory. admissionMutex is taken before tableMutex.
+    AdmissionQueue admissionQueue;
+    mutable std::mutex admissionMutex;
     
     // Helper methods for demand paging
-    void createProcessPages(const std::string& processName, size_t totalSize);
-    size_t virtualToPageNumber(size_t virtualAddress) const;
-    size_t virtualToPageOffset(size_t virtualAddress) const;
+    void initializeFrames();
+    void initializeAddressTranslation();
+    uint16_t* frameData(size_t frameNumber) const { return physicalMemory.get() + frameNumber * wordsPerFrame; }
+    uint32_t createProcessPages(const std::string& processName, size_t totalSize, bool sparse = false);
+    size_t getUsedMemory() const;
+    size_t getCommitLimit() const;
+    size_t virtualToPageNumber(size_t virtualAddress) const {
+        return pageShift != NO_PAGE_SHIFT ? virtualAddress >> pageShift : virtualAddress / PAGE_SIZE;
+    }
+    // Offset in uint16 words; the byte-to-word halving is folded into the shift
+    size_t virtualToPageOffset(size_t virtualAddress) const {
+        return pageShift != NO_PAGE_SHIFT ? (virtualAddress & pageOffsetMask) >> 1 : (virtualAddress % PAGE_SIZE) / 2;
+    }
     size_t findFreeFrame();
+    size_t reclaimFrame(uint32_t processId, bool& ownersBusy);
+    void releaseFrame(size_t frameNumber);
+    void retireFrameTag(size_t frameNumber);
+    bool tlbAccess(TLB& tlb, uint32_t processId, size_t virtualAddress, bool isWrite, uint16_t& value);
+    bool touchPage(ProcessHandle handle, size_t virtualAddress, int coreId);
     size_t selectVictimFrame();
-    void pageOut(const std::string& processName, size_t pageNumber);
-    void pageIn(const std::string& processName, size_t pageNumber, size_t frameNumber);
-    bool handlePageFault(const std::string& processName, size_t virtualAddress);
-    bool isValidVirtualAddress(const std::string& processName, size_t virtualAddress);
+    void returnSkippedFrames(const std::vector<size_t>& skipped);
+    void pageOut(uint32_t processId, size_t pageNumber);
+    std::vector<Page*> mappedPages(size_t frameNumber);
+    bool lockSharers(size_t frameNumber, uint32_t heldProcessId, std::vector<std::unique_lock<std::mutex>>& locks);
+    void writeBackFrame(size_t frameNumber);
+    void unmapSharedPage(uint32_t processId, size_t pageNumber);
+    void addMapping(size_t frameNumber, uint32_t processId, size_t pageNumber);
+    void removeMapping(size_t frameNumber, uint32_t processId, size_t pageNumber);
+    bool breakCopyOnWrite(uint32_t processId, size_t pageNumber);
+    void pageIn(uint32_t processId, size_t pageNumber, size_t frameNumber);
+    void installPage(uint32_t processId, size_t pageNumber, size_t frameNumber);
+    void readahead(uint32_t processId, size_t faultPage);
+    void evictFrame(size_t frameNumber);
+    bool faultHugePage(uint32_t processId, size_t pageNumber);
+    size_t findHugeBlock() const;
+    size_t makeHugeBlock(uint32_t processId);
+    void moveToFrame(uint32_t processId, size_t pageNumber, size_t frameNumber);
+    bool evictHugePage(uint32_t processId, size_t pageNumber);
+    void demoteHugePage(ProcessPageTable& table, size_t pageNumber);
+    bool isHugeFrame(size_t frameNumber);
+    size_t replaceLocalPage(uint32_t processId);
+    void updateWorkingSet(ProcessPageTable& table);
+    void noteReference(size_t frameNumber);
+    bool handlePageFault(uint32_t processId, size_t virtualAddress);
+    bool isValidVirtualAddress(const ProcessPageTable& table, size_t virtualAddress) const;
+    bool isValidHandle(ProcessHandle handle) const;
+    uint16_t readWord(uint32_t processId, size_t virtualAddress, TLB* tlb = nullptr);
+    void writeWord(uint32_t processId, size_t virtualAddress, uint16_t value, TLB* tlb = nullptr);
+    TLB* getTLB(int coreId) const;
+    void reclaimerLoop();
+    size_t reclaimBatch();
+    void wakeReclaimer();
+    void stopReclaimer();
+    void prefetcherLoop();
+    void prefetchPage(const PrefetchRequest& request);
+    void stopPrefetcher();
+    void dedupLoop();
+    void dedupScan();
+    void mergeFrames(size_t keptFrame, size_t duplicateFrame);
+    void mapToZeroPage(size_t frameNumber);
+    void stopDedupScanner();
     
     // Statistics helpers
-    void incrementPagesIn() { pagesIn++; }
-    void incrementPagesOut() { pagesOut++; }
-    void incrementPageFaults() { pageFaults++; }
+    void incrementPagesIn() { pagesIn.fetch_add(1, std::memory_order_relaxed); }
+    void incrementPagesOut() { pagesOut.fetch_add(1, std::memory_order_relaxed); }
+    void incrementPageFaults() { pageFaults.fetch_add(1, std::memory_order_relaxed); }
     
     // Legacy compatibility methods
-    std::vector<Frame> frames_;
-    std::map<std::shared_ptr<Screen>, std::vector<Page>> pageTables_;
-    std::queue<int> freeFrames_;
-    std::queue<int> fifoQueue_;
     int maxOverallMemory_;
     int memoryPerFrame_;
     int totalFrames_;
@@ -123,43 +481,136 @@ private:
     std::vector<uint8_t> readFromBackingStore(std::shared_ptr<Screen> process, int pageNumber);
     
 public:
-    MemoryManager(size_t totalMem);
+    MemoryManager(size_t totalMem, const std::string& backingStoreFile = "csopesy-backing-store.bin");
     MemoryManager(int maxOverallMemory, int memoryPerFrame);  // Legacy constructor
     ~MemoryManager();
     
-    // New demand paging interface
+    // New demand paging interface. allocateMemory returns INVALID_PROCESS_HANDLE on failure.
+    // coreId selects the per-core TLB of the calling core; -1 skips the TLB.
+    ProcessHandle allocateMemory(const std::string& processName, size_t size);
+    // Reserve a sparse address space of up to MAX_RESERVATION_SIZE bytes. It is not
+    // charged against the commit limit, and its page table only grows leaves for the
+    // regions the process touches. Freed with deallocateMemory like any other process.
+    // 4 GB, or the largest power of two a 32-bit size_t can hold.
+    static const size_t MAX_RESERVATION_SIZE = static_cast<size_t>(1) << (sizeof(size_t) > 4 ? 32 : 31);
+    ProcessHandle reserveAddressSpace(const std::string& processName, size_t size);
+    void deallocateMemory(const std::string& processName);
+    // Give childName a copy of the parent's address space. Resident pages are shared
+    // copy-on-write and swapped pages share their slot, so nothing is copied up front.
+    ProcessHandle forkProcess(ProcessHandle parent, const std::string& childName);
+    uint16_t readMemory(ProcessHandle handle, size_t virtualAddress, int coreId = -1);
+    void writeMemory(ProcessHandle handle, size_t virtualAddress, uint16_t value, int coreId = -1);
+    
+    // Name-based access (looks the process up on every call)
     uint16_t readMemory(const std::string& processName, size_t virtualAddress);
     void writeMemory(const std::string& processName, size_t virtualAddress, uint16_t value);
-    bool allocateMemory(const std::string& processName, size_t size);
-    void deallocateMemory(const std::string& processName);
+    ProcessHandle getProcessHandle(const std::string& processName) const;
     
     // Force memory access for instruction execution (Test Case 6 optimization)
+    bool simulateInstructionMemoryAccess(ProcessHandle handle, int coreId = -1);
     bool simulateInstructionMemoryAccess(const std::string& processName);
     
     // Legacy interface for compatibility
     bool allocateMemory(std::shared_ptr<Screen> process, int memorySize);
     void deallocateMemory(std::shared_ptr<Screen> process);
-    bool accessMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, bool isWrite = false);
+    bool accessMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, bool isWrite = false, int coreId = -1);
     bool readMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, uint16_t& value);
     bool writeMemory(std::shared_ptr<Screen> process, uint32_t virtualAddress, uint16_t value);
     bool handlePageFault(std::shared_ptr<Screen> process, int pageNumber);
     
+    // Page replacement policy (fifo, clock, second-chance, lru); false if the name is unknown
+    bool setReplacementPolicy(const std::string& policyName);
+    std::string getReplacementPolicyName() const;
+    
+    // Swap space available for overcommit. Processes are admitted while their total
+    // virtual size fits in physical memory plus swap; 0 disables overcommit.
+    void setSwapCapacity(size_t bytes);
+    size_t getSwapCapacity() const;
+    
+    // Free-frame watermarks for the background reclaimer (clamped to the frame count);
+    // a low watermark of 0 stops it
+    void setReclaimWatermarks(size_t lowFrames, size_t highFrames);
+    
+    // Queue the given pages of the process to be loaded in the background ahead of use.
+    // Only swapped-out pages are queued, and at most the prefetch budget per process.
+    void prefetchPages(ProcessHandle handle, const std::vector<size_t>& virtualAddresses);
+    // Prefetch requests a process may have waiting; 0 turns prefetching off
+    void setPrefetchBudget(size_t pages);
+    bool isPrefetchEnabled() const { return prefetchBudget > 0; }
+    
+    // Frames the deduplication scanner checks per pass; 0 stops it
+    void setDedupScanRate(size_t pagesPerScan);
+    
+    // Instructions per working-set window; 0 turns frame quotas and load control off
+    void setWorkingSetWindow(size_t instructions);
+    bool isWorkingSetTracked() const { return workingSetWindow > 0; }
+    // Called by the scheduler around each run of a process. reserveWorkingSet is false
+    // when the process's quota does not fit beside those already running, and the
+    // scheduler should hold it back; a process running alone is always let through.
+    bool reserveWorkingSet(ProcessHandle handle);
+    void releaseWorkingSet(ProcessHandle handle);
+    
+    // Medium-term swapping of whole processes, driven by the scheduler
+    void setProcessSwapping(bool enabled);
+    bool isProcessSwappingEnabled() const { return processSwapping; }
+    // The processes not swapped out have more pages than there are frames
+    bool isOversubscribed() const;
+    // Enough free frames to bring back the process's recorded resident set
+    bool hasHeadroomFor(ProcessHandle handle);
+    // Write out and free every private resident page of the process in one batch.
+    // False if the process is invalid or already swapped out.
+    bool swapOutProcess(ProcessHandle handle);
+    // Load the recorded resident set into whatever frames are free; the rest of it
+    // faults back in on demand. False if the process was not swapped out.
+    bool swapInProcess(ProcessHandle handle);
+    
+    // Huge page size in bytes: a power-of-two multiple of the page size, at least two
+    // pages and at most physical memory. 0 disables huge pages; false if invalid.
+    bool setHugePageSize(size_t bytes);
+    
+    // Largest readahead window in pages; 0 turns readahead off
+    void setMaxReadahead(size_t pages);
+    
+    // Dirty page-outs queued for the background writer before evictions wait; 0 writes synchronously
+    void setWritebackQueueSize(size_t pages);
+    // Bytes of compressed swapped-out pages kept in memory ahead of the backing store file; 0 disables it
+    void setCompressedPoolSize(size_t bytes);
+    
+    // Access model for simulated instruction accesses (realistic, stress); false if the name is unknown
+    bool setAccessModel(const std::string& modelName);
+    std::string getAccessModelName() const;
+    
+    // Admission queue for processes created while memory is fully committed.
+    // enqueueAdmission marks the process WAITING (false if it could never fit);
+    // admitWaitingProcesses allocates memory for whichever waiting processes fit now,
+    // marks them READY and returns them for the caller to schedule.
+    bool setAdmissionPolicy(const std::string& policyName);
+    bool enqueueAdmission(std::shared_ptr<Screen> process, size_t memorySize);
+    std::vector<std::shared_ptr<Screen>> admitWaitingProcesses();
+    
     // Memory validation
     static bool isValidMemorySize(size_t size);
     
     // Statistics and monitoring
     struct MemorySnapshot {
         size_t totalMemory;
+        size_t swapCapacity;
         size_t usedMemory;
         size_t availableMemory;
         size_t fragmentationCount;
         size_t largestFreeBlock;
         size_t activeProcesses;
         size_t inactiveProcesses;
+        size_t residentPages;
+        size_t swappedPages;
         std::vector<std::pair<std::string, size_t>> processMemory;
         size_t pagesIn;
         size_t pagesOut;
         size_t pageFaults;
+        size_t dirtyEvictions;
+        size_t cleanEvictions;
+        size_t tlbHits;
+        size_t tlbMisses;
         size_t idleCpuTicks;
         size_t activeCpuTicks;
         size_t totalCpuTicks;
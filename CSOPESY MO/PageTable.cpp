@@ -0,0 +1,61 @@
+#include "PageTable.h"
+
+const Page PageTable::untouchedPage;
+
+void PageTable::assign(size_t numPages) {
+    this->numPages = numPages;
+    allocatedLeaves = 0;
+    rootLeaf.reset();
+    rootDirectory.reset();
+    std::vector<std::unique_ptr<Directory>>().swap(topDirectories);
+
+    size_t numLeaves = (numPages + LEAF_PAGES - 1) / LEAF_PAGES;
+    if (numLeaves <= 1) {
+        levels = 1;
+    } else if (numLeaves <= DIRECTORY_ENTRIES) {
+        levels = 2;
+        rootDirectory = std::make_unique<Directory>();
+    } else {
+        levels = 3;
+        topDirectories.resize((numLeaves + DIRECTORY_ENTRIES - 1) / DIRECTORY_ENTRIES);
+    }
+}
+
+size_t PageTable::getFootprintBytes() const {
+    size_t bytes = 0;
+    if (levels == 2) {
+        bytes += sizeof(Directory);
+    } else if (levels == 3) {
+        bytes += topDirectories.size() * sizeof(std::unique_ptr<Directory>);
+        for (const auto& directory : topDirectories) {
+            if (directory) {
+                bytes += sizeof(Directory);
+            }
+        }
+    }
+    // Only the last leaf can be short, so counting full leaves is close enough
+    return bytes + allocatedLeaves * std::min(numPages, LEAF_PAGES) * sizeof(Page);
+}
+
+PageTable::Leaf* PageTable::findLeaf(size_t pageNumber) const {
+    if (pageNumber >= numPages) {
+        return nullptr;
+    }
+    if (levels == 1) {
+        return rootLeaf.get();
+    }
+    size_t leafIndex = pageNumber >> LEAF_BITS;
+    if (levels == 2) {
+        return rootDirectory->leaves[leafIndex].get();
+    }
+    const std::unique_ptr<Directory>& directory = topDirectories[leafIndex >> DIRECTORY_BITS];
+    return directory ? directory->leaves[leafIndex & DIRECTORY_MASK].get() : nullptr;
+}
+
+// The last leaf only holds the pages left over, so small tables stay small
+void PageTable::allocateLeaf(std::unique_ptr<Leaf>& leaf, size_t pageNumber) {
+    size_t leafStart = pageNumber & ~LEAF_MASK;
+    leaf = std::make_unique<Leaf>();
+    leaf->pages.resize(std::min(LEAF_PAGES, numPages - leafStart));
+    allocatedLeaves++;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include <vector>
+#include <memory>
+#include <array>
+#include <algorithm>
+#include <cstddef>
+
+#include "BackingStore.h"
+
+struct Page {
+    size_t frameNumber;
+    size_t backingSlot;          // Slot holding the page while it is not in memory, NO_SLOT until first written back
+    bool isInMemory;
+    bool prefetchQueued;         // A prefetch request for the page is waiting
+    bool copyOnWrite;            // Mapped to a frame another process shares; the first write copies it
+    bool huge;                   // Part of a huge page: faulted in and evicted with the rest of its region
+
+    Page() : frameNumber(static_cast<size_t>(-1)), backingSlot(BackingStore::NO_SLOT), isInMemory(false),
+             prefetchQueued(false), copyOnWrite(false), huge(false) {}
+
+    // Never written, or only ever held zeros: reads are served by the shared zero page
+    bool isZeroMapped() const { return !isInMemory && backingSlot == BackingStore::NO_SLOT; }
+};
+
+// Radix page table of one process. Pages live in leaves of LEAF_PAGES entries, and
+// a leaf is only allocated once a page in it is used, so a large sparse address
+// space costs memory only for the regions the process touches. A table of up to
+// LEAF_PAGES pages is a single leaf; larger ones put a directory of leaves above
+// it, and past LEAF_PAGES * DIRECTORY_ENTRIES pages a top level of directories.
+// Leaves never move once allocated, so Page references stay valid until assign.
+// Not thread-safe: the owning process's lock guards it like the pages themselves.
+class PageTable {
+public:
+    static const size_t LEAF_BITS = 9;
+    static const size_t LEAF_PAGES = static_cast<size_t>(1) << LEAF_BITS;
+    static const size_t DIRECTORY_BITS = 9;
+    static const size_t DIRECTORY_ENTRIES = static_cast<size_t>(1) << DIRECTORY_BITS;
+
+    // Drop every page and start over with numPages untouched ones
+    void assign(size_t numPages);
+    void clear() { assign(0); }
+
+    size_t size() const { return numPages; }
+    int getLevels() const { return levels; }
+    size_t getAllocatedLeaves() const { return allocatedLeaves; }
+    size_t getFootprintBytes() const;   // Leaves and directories currently allocated
+
+    // Allocates the leaf holding the page on first use
+    Page& operator[](size_t pageNumber) {
+        std::unique_ptr<Leaf>& leaf = leafSlot(pageNumber);
+        if (!leaf) {
+            allocateLeaf(leaf, pageNumber);
+        }
+        return leaf->pages[pageNumber & LEAF_MASK];
+    }
+
+    // Never allocates: a page in a leaf that does not exist yet reads as untouched
+    const Page& operator[](size_t pageNumber) const {
+        const Leaf* leaf = findLeaf(pageNumber);
+        return leaf ? leaf->pages[pageNumber & LEAF_MASK] : untouchedPage;
+    }
+
+    // Visit the pages in [first, last) whose leaves exist, in page order, as
+    // visit(pageNumber, page). Stops early and returns false once visit returns false.
+    template <typename Visitor>
+    bool forEachPageUntil(size_t first, size_t last, Visitor visit) {
+        last = std::min(last, numPages);
+        size_t pageNumber = first;
+        while (pageNumber < last) {
+            size_t leafEnd = std::min(((pageNumber >> LEAF_BITS) + 1) << LEAF_BITS, last);
+            Leaf* leaf = findLeaf(pageNumber);
+            for (; leaf && pageNumber < leafEnd; pageNumber++) {
+                if (!visit(pageNumber, leaf->pages[pageNumber & LEAF_MASK])) {
+                    return false;
+                }
+            }
+            pageNumber = leafEnd;
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    void forEachPage(Visitor visit) {
+        forEachPageUntil(0, numPages, [&visit](size_t pageNumber, Page& page) {
+            visit(pageNumber, page);
+            return true;
+        });
+    }
+
+private:
+    static const size_t LEAF_MASK = LEAF_PAGES - 1;
+    static const size_t DIRECTORY_MASK = DIRECTORY_ENTRIES - 1;
+
+    struct Leaf {
+        std::vector<Page> pages;
+    };
+    struct Directory {
+        std::array<std::unique_ptr<Leaf>, DIRECTORY_ENTRIES> leaves;
+    };
+
+    std::unique_ptr<Leaf>& leafSlot(size_t pageNumber) {
+        if (levels == 1) {
+            return rootLeaf;
+        }
+        size_t leafIndex = pageNumber >> LEAF_BITS;
+        if (levels == 2) {
+            return rootDirectory->leaves[leafIndex];
+        }
+        std::unique_ptr<Directory>& directory = topDirectories[leafIndex >> DIRECTORY_BITS];
+        if (!directory) {
+            directory = std::make_unique<Directory>();
+        }
+        return directory->leaves[leafIndex & DIRECTORY_MASK];
+    }
+
+    Leaf* findLeaf(size_t pageNumber) const;
+    void allocateLeaf(std::unique_ptr<Leaf>& leaf, size_t pageNumber);
+
+    size_t numPages = 0;
+    int levels = 1;
+    size_t allocatedLeaves = 0;
+    std::unique_ptr<Leaf> rootLeaf;                              // levels == 1
+    std::unique_ptr<Directory> rootDirectory;                    // levels == 2
+    std::vector<std::unique_ptr<Directory>> topDirectories;      // levels == 3, filled in on demand
+
+    static const Page untouchedPage;
+};
+
+#endif // PAGE_TABLE_H
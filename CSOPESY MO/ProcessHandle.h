@@ -0,0 +1,12 @@
+#pragma once
+#ifndef PROCESS_HANDLE_H
+#define PROCESS_HANDLE_H
+
+#include <cstdint>
+
+// Compact process handle returned by allocateMemory: an index into the dense
+// page table array, so the per-instruction memory path needs no name lookups.
+using ProcessHandle = int32_t;
+constexpr ProcessHandle INVALID_PROCESS_HANDLE = -1;
+
+#endif // PROCESS_HANDLE_H
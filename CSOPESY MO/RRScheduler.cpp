@@ -5,6 +5,7 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
 
 RRScheduler::RRScheduler(int cores, int delaysPerExec, int quantumCycles)
     : Scheduler(cores), delaysPerExec_(delaysPerExec), quantumCycles_(quantumCycles) {
@@ -27,6 +28,20 @@ void RRScheduler::cpuWorker(int coreId) {
         lock.unlock();
 
         if (process) {
+            // Hold the process back while its working set does not fit beside those running
+            if (globalMemoryManager && !globalMemoryManager->reserveWorkingSet(process->getMemoryHandle())) {
+                {
+                    std::lock_guard<std::mutex> queueLock(queueMutex);
+                    process->setStatus("READY");
+                    readyQueue.push(process);
+                    cpuCores[coreId].isBusy = false;
+                    cpuCores[coreId].currentProcess = nullptr;
+                }
+                schedulerCV.notify_all();
+                std::this_thread::sleep_for(std::chrono::milliseconds(std::max(delaysPerExec_, 1)));
+                continue;
+            }
+
             int executedInQuantum = 0;
             bool processFinished = false;
 
@@ -39,7 +54,7 @@ void RRScheduler::cpuWorker(int coreId) {
                 // Trigger memory access for demand paging before instruction execution
                 if (globalMemoryManager) {
                     uint32_t virtualAddress = process->getCurrentBurst() * 4;
-                    globalMemoryManager->accessMemory(process, virtualAddress, false);
+                    globalMemoryManager->accessMemory(process, virtualAddress, false, coreId);
                 }
 
                 process->executeInstruction(coreId);
@@ -48,17 +63,47 @@ void RRScheduler::cpuWorker(int coreId) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(delaysPerExec_));
             }
 
+            if (globalMemoryManager) {
+                globalMemoryManager->releaseWorkingSet(process->getMemoryHandle());
+            }
+
             if (processFinished || process->getCurrentBurst() >= process->getTotalBurst()) {
                 {
                     std::lock_guard<std::mutex> finishedLock(finishedMutex);
                     process->setStatus("FINISHED");
                     finishedProcesses.push_back(process);
                 }
+
+                // Release the process memory and schedule whichever waiting processes now fit
+                if (globalMemoryManager) {
+                    globalMemoryManager->deallocateMemory(process);
+                    for (auto& admitted : globalMemoryManager->admitWaitingProcesses()) {
+                        addProcess(admitted);
+                    }
+                }
             }
             else {
+                // While memory is oversubscribed, a preempted process that others are
+                // waiting behind leaves memory in one batch instead of page by page
+                bool othersWaiting;
+                {
+                    std::lock_guard<std::mutex> queueLock(queueMutex);
+                    othersWaiting = !readyQueue.empty();
+                }
+                bool swappedOut = othersWaiting && globalMemoryManager &&
+                    globalMemoryManager->isProcessSwappingEnabled() &&
+                    globalMemoryManager->isOversubscribed() &&
+                    globalMemoryManager->swapOutProcess(process->getMemoryHandle());
+
                 std::lock_guard<std::mutex> queueLock(queueMutex);
-                process->setStatus("READY");
-                readyQueue.push(process);
+                if (swappedOut) {
+                    process->setStatus("SWAPPED");
+                    swappedOutProcesses.push_back(process);
+                }
+                else {
+                    process->setStatus("READY");
+                    readyQueue.push(process);
+                }
             }
 
             {
@@ -71,8 +116,37 @@ void RRScheduler::cpuWorker(int coreId) {
     }
 }
 
+// Bring back the oldest swapped-out process once its resident set fits in the free
+// frames, or straight away when no other process could use the CPU
+void RRScheduler::swapInWaitingProcess() {
+    std::shared_ptr<Screen> process;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (swappedOutProcesses.empty()) {
+            return;
+        }
+
+        bool idle = readyQueue.empty();
+        for (const auto& core : cpuCores) {
+            idle = idle && !core.isBusy;
+        }
+        if (!idle && !globalMemoryManager->hasHeadroomFor(swappedOutProcesses.front()->getMemoryHandle())) {
+            return;
+        }
+        process = swappedOutProcesses.front();
+        swappedOutProcesses.pop_front();
+    }
+
+    globalMemoryManager->swapInProcess(process->getMemoryHandle());
+    addProcess(process);
+}
+
 void RRScheduler::scheduler() {
     while (running) {
+        if (globalMemoryManager && globalMemoryManager->isProcessSwappingEnabled()) {
+            swapInWaitingProcess();
+        }
+
         std::unique_lock<std::mutex> lock(queueMutex);
 
         bool hasActivity = false;
@@ -179,6 +253,10 @@ void RRScheduler::printStatus() {
         std::cout << process->getName() << "\t(" << process->getCreateTimestamp() << ")\tReady"
             << "\t" << process->getCurrentBurst() << " / " << process->getTotalBurst() << "\n";
     }
+    for (const auto& process : swappedOutProcesses) {
+        std::cout << process->getName() << "\t(" << process->getCreateTimestamp() << ")\tSwapped out"
+            << "\t" << process->getCurrentBurst() << " / " << process->getTotalBurst() << "\n";
+    }
 
     std::cout << "\nFinished processes:\n";
     for (const auto& process : finishedProcesses) {
@@ -199,7 +277,7 @@ bool RRScheduler::allProcessesFinished() {
         }
     }
 
-    return readyQueue.empty();
+    return readyQueue.empty() && swappedOutProcesses.empty();
 }
 
 void RRScheduler::writeFinishedProcessLogs() {
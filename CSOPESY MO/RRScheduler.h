@@ -1,5 +1,6 @@
 #pragma once
 #include <queue>
+#include <deque>
 #include <vector>
 #include <memory>
 
@@ -11,8 +12,11 @@ private:
     int delaysPerExec_;
     int quantumCycles_;
     std::queue<std::shared_ptr<Screen>> readyQueue;
+    std::deque<std::shared_ptr<Screen>> swappedOutProcesses;   // Preempted and swapped out, oldest first
     std::vector<std::shared_ptr<Screen>> finishedProcesses;
 
+    void swapInWaitingProcess();
+
 public:
     RRScheduler(int cores, int delaysPerExec, int quantumCycles);
     virtual ~RRScheduler();
@@ -0,0 +1,196 @@
+#include "ReplacementPolicy.h"
+#include <algorithm>
+#include <cctype>
+
+// ===== FIFO =====
+FIFOPolicy::FIFOPolicy(size_t numFrames)
+    : ReplacementPolicy(numFrames), loadedFrames(numFrames) {
+}
+
+// A reloaded frame goes to the back again
+void FIFOPolicy::frameLoaded(size_t frameId) {
+    if (frameId >= numFrames) return;
+    loadedFrames.pushBack(frameId);
+}
+
+void FIFOPolicy::frameReleased(size_t frameId) {
+    if (frameId >= numFrames) return;
+    loadedFrames.remove(frameId);
+}
+
+size_t FIFOPolicy::selectVictim() {
+    if (loadedFrames.empty()) return NO_FRAME;
+    size_t frameId = loadedFrames.front();
+    loadedFrames.remove(frameId);
+    return frameId;
+}
+
+// Still the oldest page, so it goes back to the front
+void FIFOPolicy::frameSkipped(size_t frameId) {
+    if (frameId >= numFrames) return;
+    loadedFrames.pushFront(frameId);
+}
+
+// ===== CLOCK =====
+ClockPolicy::ClockPolicy(size_t numFrames)
+    : ReplacementPolicy(numFrames), resident(numFrames, 0), referenced(numFrames) {
+}
+
+void ClockPolicy::frameLoaded(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 1;
+    referenced.set(frameId);
+}
+
+void ClockPolicy::frameReferenced(size_t frameId) {
+    if (frameId >= numFrames) return;
+    referenced.set(frameId);
+}
+
+void ClockPolicy::frameReleased(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 0;
+    referenced.clear(frameId);
+}
+
+size_t ClockPolicy::selectVictim() {
+    if (numFrames == 0) return NO_FRAME;
+
+    // Two sweeps are enough: the first clears every referenced bit
+    for (size_t step = 0; step < 2 * numFrames; step++) {
+        size_t frameId = hand;
+        hand = (hand + 1) % numFrames;
+
+        if (!resident[frameId]) continue;
+        if (referenced.testAndClear(frameId)) {
+            continue;  // Second chance
+        }
+        resident[frameId] = 0;
+        return frameId;
+    }
+    return NO_FRAME;
+}
+
+// Back on the ring where it was, with whatever references it picked up meanwhile
+void ClockPolicy::frameSkipped(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 1;
+}
+
+// ===== SECOND CHANCE =====
+SecondChancePolicy::SecondChancePolicy(size_t numFrames)
+    : ReplacementPolicy(numFrames), loadedFrames(numFrames), referenced(numFrames) {
+}
+
+void SecondChancePolicy::frameLoaded(size_t frameId) {
+    if (frameId >= numFrames) return;
+    referenced.clear(frameId);
+    loadedFrames.pushBack(frameId);
+}
+
+void SecondChancePolicy::frameReferenced(size_t frameId) {
+    if (frameId >= numFrames) return;
+    referenced.set(frameId);
+}
+
+void SecondChancePolicy::frameReleased(size_t frameId) {
+    if (frameId >= numFrames) return;
+    loadedFrames.remove(frameId);
+    referenced.clear(frameId);
+}
+
+size_t SecondChancePolicy::selectVictim() {
+    // Every frame is requeued at most once before one is chosen
+    size_t requeued = 0;
+    while (!loadedFrames.empty()) {
+        size_t frameId = loadedFrames.front();
+        loadedFrames.remove(frameId);
+        if (requeued <= numFrames && referenced.testAndClear(frameId)) {
+            loadedFrames.pushBack(frameId);
+            requeued++;
+            continue;
+        }
+        return frameId;
+    }
+    return NO_FRAME;
+}
+
+void SecondChancePolicy::frameSkipped(size_t frameId) {
+    if (frameId >= numFrames) return;
+    loadedFrames.pushFront(frameId);
+}
+
+// ===== LRU APPROXIMATION (AGING) =====
+AgingPolicy::AgingPolicy(size_t numFrames)
+    : ReplacementPolicy(numFrames), resident(numFrames, 0), referenced(numFrames), age(numFrames, 0) {
+}
+
+void AgingPolicy::frameLoaded(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 1;
+    referenced.set(frameId);
+    age[frameId] = 0;
+}
+
+void AgingPolicy::frameReferenced(size_t frameId) {
+    if (frameId >= numFrames) return;
+    referenced.set(frameId);
+}
+
+void AgingPolicy::frameReleased(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 0;
+    referenced.clear(frameId);
+    age[frameId] = 0;
+}
+
+// Shift every counter right and feed the referenced bit into the top
+void AgingPolicy::tick() {
+    for (size_t i = 0; i < numFrames; i++) {
+        if (!resident[i]) continue;
+        age[i] = static_cast<uint8_t>((age[i] >> 1) | (referenced.testAndClear(i) << 7));
+    }
+}
+
+size_t AgingPolicy::selectVictim() {
+    if (numFrames == 0) return NO_FRAME;
+
+    size_t victim = NO_FRAME;
+    unsigned int lowest = 0;
+
+    for (size_t step = 0; step < numFrames; step++) {
+        size_t frameId = (scanStart + step) % numFrames;
+        if (!resident[frameId]) continue;
+
+        // A reference since the last tick counts as more recent than any history
+        unsigned int key = (static_cast<unsigned int>(referenced.test(frameId)) << 8) | age[frameId];
+        if (victim == NO_FRAME || key < lowest) {
+            victim = frameId;
+            lowest = key;
+            if (key == 0) break;
+        }
+    }
+
+    if (victim != NO_FRAME) {
+        scanStart = (victim + 1) % numFrames;
+        resident[victim] = 0;
+    }
+    return victim;
+}
+
+// Its age is kept, so it stays the likeliest victim of the next pass
+void AgingPolicy::frameSkipped(size_t frameId) {
+    if (frameId >= numFrames) return;
+    resident[frameId] = 1;
+}
+
+std::unique_ptr<ReplacementPolicy> createReplacementPolicy(const std::string& name, size_t numFrames) {
+    std::string key = name;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+
+    if (key == "fifo") return std::make_unique<FIFOPolicy>(numFrames);
+    if (key == "clock") return std::make_unique<ClockPolicy>(numFrames);
+    if (key == "second-chance") return std::make_unique<SecondChancePolicy>(numFrames);
+    if (key == "lru" || key == "aging") return std::make_unique<AgingPolicy>(numFrames);
+    return nullptr;
+}
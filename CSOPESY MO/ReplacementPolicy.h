@@ -0,0 +1,209 @@
+#pragma once
+#ifndef REPLACEMENT_POLICY_H
+#define REPLACEMENT_POLICY_H
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+// Page replacement policy used by MemoryManager when no free frame is left.
+// The memory manager reports frame events; the policy only decides which
+// resident frame to give up next. All calls happen under the frame lock,
+// except frameReferenced, which the resident-page fast path makes without it.
+class ReplacementPolicy {
+public:
+    static const size_t NO_FRAME = static_cast<size_t>(-1);
+
+    explicit ReplacementPolicy(size_t numFrames) : numFrames(numFrames) {}
+    virtual ~ReplacementPolicy() = default;
+
+    virtual const char* getName() const = 0;
+
+    // A page was loaded into the frame
+    virtual void frameLoaded(size_t frameId) = 0;
+    // The resident page in the frame was read or written. May run concurrently
+    // with any other call, so it must only touch atomic state.
+    virtual void frameReferenced(size_t /*frameId*/) {}
+    // The frame was freed (evicted or process deallocated)
+    virtual void frameReleased(size_t frameId) = 0;
+    // Pick the next frame to evict, NO_FRAME if nothing is resident. The frame is no
+    // longer a candidate: the caller evicts it, or hands it back with frameSkipped.
+    virtual size_t selectVictim() = 0;
+    // A frame from selectVictim could not be evicted and stays resident. Unlike
+    // frameLoaded it keeps the frame's place and history. Frames passed over in one
+    // pass are handed back most recently selected first.
+    virtual void frameSkipped(size_t frameId) = 0;
+    // Periodic hook driven by CPU ticks
+    virtual void tick() {}
+    // Whether the frame was used recently enough that evicting it is likely to
+    // fault it straight back; policies without reference history say no
+    virtual bool isRecentlyReferenced(size_t /*frameId*/) const { return false; }
+
+protected:
+    size_t numFrames;
+};
+
+// Per-frame referenced bits shared between the lock-free reference path and the victim scan
+class ReferenceBits {
+public:
+    explicit ReferenceBits(size_t numFrames) : bits(new std::atomic<uint8_t>[numFrames]) {
+        for (size_t i = 0; i < numFrames; i++) {
+            bits[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void set(size_t frameId) { bits[frameId].store(1, std::memory_order_relaxed); }
+    void clear(size_t frameId) { bits[frameId].store(0, std::memory_order_relaxed); }
+    uint8_t test(size_t frameId) const { return bits[frameId].load(std::memory_order_relaxed); }
+    // Read and clear in one step so a concurrent reference is never lost
+    uint8_t testAndClear(size_t frameId) { return bits[frameId].exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::unique_ptr<std::atomic<uint8_t>[]> bits;
+};
+
+// Resident frames in load order, linked through per-frame prev/next indices, so it
+// holds each frame at most once and never more than numFrames entries
+class FrameQueue {
+public:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    explicit FrameQueue(size_t numFrames) : prev(numFrames, NONE), next(numFrames, NONE), queued(numFrames, 0) {}
+
+    bool empty() const { return head == NONE; }
+    size_t front() const { return head; }
+
+    // Append the frame, moving it to the back if it is already queued
+    void pushBack(size_t frameId) {
+        remove(frameId);
+        prev[frameId] = tail;
+        next[frameId] = NONE;
+        if (tail != NONE) {
+            next[tail] = frameId;
+        } else {
+            head = frameId;
+        }
+        tail = frameId;
+        queued[frameId] = 1;
+    }
+
+    void pushFront(size_t frameId) {
+        remove(frameId);
+        prev[frameId] = NONE;
+        next[frameId] = head;
+        if (head != NONE) {
+            prev[head] = frameId;
+        } else {
+            tail = frameId;
+        }
+        head = frameId;
+        queued[frameId] = 1;
+    }
+
+    void remove(size_t frameId) {
+        if (!queued[frameId]) return;
+        if (prev[frameId] != NONE) {
+            next[prev[frameId]] = next[frameId];
+        } else {
+            head = next[frameId];
+        }
+        if (next[frameId] != NONE) {
+            prev[next[frameId]] = prev[frameId];
+        } else {
+            tail = prev[frameId];
+        }
+        prev[frameId] = next[frameId] = NONE;
+        queued[frameId] = 0;
+    }
+
+private:
+    std::vector<size_t> prev;
+    std::vector<size_t> next;
+    std::vector<uint8_t> queued;
+    size_t head = NONE;
+    size_t tail = NONE;
+};
+
+// First in, first out
+class FIFOPolicy : public ReplacementPolicy {
+public:
+    explicit FIFOPolicy(size_t numFrames);
+
+    const char* getName() const override { return "FIFO"; }
+    void frameLoaded(size_t frameId) override;
+    void frameReleased(size_t frameId) override;
+    size_t selectVictim() override;
+    void frameSkipped(size_t frameId) override;
+
+private:
+    FrameQueue loadedFrames;
+};
+
+// CLOCK: circular hand over the frame table, skipping (and clearing) referenced frames
+class ClockPolicy : public ReplacementPolicy {
+public:
+    explicit ClockPolicy(size_t numFrames);
+
+    const char* getName() const override { return "CLOCK"; }
+    void frameLoaded(size_t frameId) override;
+    void frameReferenced(size_t frameId) override;
+    void frameReleased(size_t frameId) override;
+    size_t selectVictim() override;
+    void frameSkipped(size_t frameId) override;
+    bool isRecentlyReferenced(size_t frameId) const override { return referenced.test(frameId) != 0; }
+
+private:
+    std::vector<uint8_t> resident;
+    ReferenceBits referenced;
+    size_t hand = 0;
+};
+
+// Second chance: FIFO order, but a referenced page is moved to the back once
+class SecondChancePolicy : public ReplacementPolicy {
+public:
+    explicit SecondChancePolicy(size_t numFrames);
+
+    const char* getName() const override { return "SECOND-CHANCE"; }
+    void frameLoaded(size_t frameId) override;
+    void frameReferenced(size_t frameId) override;
+    void frameReleased(size_t frameId) override;
+    size_t selectVictim() override;
+    void frameSkipped(size_t frameId) override;
+    bool isRecentlyReferenced(size_t frameId) const override { return referenced.test(frameId) != 0; }
+
+private:
+    FrameQueue loadedFrames;
+    ReferenceBits referenced;
+};
+
+// LRU approximation with 8-bit aging counters shifted on every tick
+class AgingPolicy : public ReplacementPolicy {
+public:
+    explicit AgingPolicy(size_t numFrames);
+
+    const char* getName() const override { return "LRU-AGING"; }
+    void frameLoaded(size_t frameId) override;
+    void frameReferenced(size_t frameId) override;
+    void frameReleased(size_t frameId) override;
+    size_t selectVictim() override;
+    void frameSkipped(size_t frameId) override;
+    void tick() override;
+    // Referenced since the last tick, or during the tick before it
+    bool isRecentlyReferenced(size_t frameId) const override {
+        return referenced.test(frameId) != 0 || (age[frameId] & 0x80) != 0;
+    }
+
+private:
+    std::vector<uint8_t> resident;
+    ReferenceBits referenced;
+    std::vector<uint8_t> age;
+    size_t scanStart = 0;  // Rotates so ties do not always hit the same frames
+};
+
+// Build a policy from its config name (fifo, clock, second-chance, lru/aging).
+// Returns nullptr for an unknown name.
+std::unique_ptr<ReplacementPolicy> createReplacementPolicy(const std::string& name, size_t numFrames);
+
+#endif // REPLACEMENT_POLICY_H
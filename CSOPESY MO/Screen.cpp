@@ -32,6 +32,17 @@ Screen::Screen(int id, const std::string& name, int totalBurst)
 	generateInstructions();
 }
 
+std::shared_ptr<Screen> Screen::fork(int id, const std::string& name) const {
+	std::shared_ptr<Screen> child = std::make_shared<Screen>(*this);
+	child->id_ = id;
+	child->name_ = name;
+	child->status_ = "CREATED";
+	child->createTimestamp_ = child->getCurrentTimeStamp();
+	child->logEntries_.clear();
+	child->memoryHandle_ = INVALID_PROCESS_HANDLE;
+	return child;
+}
+
 void Screen::setCustomInstructions(const std::vector<std::string>& customInstructions) {
 	instructions_.clear();
 	
@@ -370,6 +381,8 @@ Screen::Instruction Screen::generateRandomNonLoopInstruction(std::mt19937& gen)
 
 
 void Screen::executeInstruction(int coreId) {
+	std::lock_guard<std::mutex> executionGuard(executionLock_.mutex);
+
 	// Handle sleep ticks
 	if (sleepTicksRemaining_ > 0) {
 		sleepTicksRemaining_--;
@@ -384,7 +397,12 @@ void Screen::executeInstruction(int coreId) {
 
 	// Simulate memory access for instruction fetch and execution (Test Case 6 optimization)
 	if (globalMemoryManager) {
-		globalMemoryManager->simulateInstructionMemoryAccess(name_);
+		// Look ahead before this instruction's own accesses fault its pages in, so the
+		// pages still missing are the ones worth asking for
+		if (globalMemoryManager->isPrefetchEnabled() && currentBurst_ % PREFETCH_INTERVAL == 0) {
+			prefetchUpcomingPages();
+		}
+		globalMemoryManager->simulateInstructionMemoryAccess(memoryHandle_, coreId);
 	}
 
 	Instruction& inst = instructions_[pc_];
@@ -444,7 +462,7 @@ void Screen::executeInstruction(int coreId) {
 			// Write variable to memory through memory manager
 			if (globalMemoryManager) {
 				try {
-					globalMemoryManager->writeMemory(name_, symbolTableAddress, value);
+					globalMemoryManager->writeMemory(memoryHandle_, symbolTableAddress, value, coreId);
 					logMessage = "DECLARE: " + varName + " = " + std::to_string(value) + 
 								" (stored at 0x" + std::to_string(symbolTableAddress) + ")";
 				} catch (const std::exception&) {
@@ -485,7 +503,7 @@ void Screen::executeInstruction(int coreId) {
 				}
 				size_t symbolTableAddress = variableIndex * 2; // 2 bytes per uint16
 				
-				globalMemoryManager->writeMemory(name_, symbolTableAddress, result);
+				globalMemoryManager->writeMemory(memoryHandle_, symbolTableAddress, result, coreId);
 				logMessage = "ADD: " + var1 + " = " + std::to_string(val2) + " + " + std::to_string(val3) + 
 							" (stored at 0x" + std::to_string(symbolTableAddress) + ")";
 			} catch (const std::exception&) {
@@ -525,7 +543,7 @@ void Screen::executeInstruction(int coreId) {
 				}
 				size_t symbolTableAddress = variableIndex * 2; // 2 bytes per uint16
 				
-				globalMemoryManager->writeMemory(name_, symbolTableAddress, result);
+				globalMemoryManager->writeMemory(memoryHandle_, symbolTableAddress, result, coreId);
 				logMessage = "SUBTRACT: " + var1 + " = " + std::to_string(val2) + " - " + std::to_string(val3) + 
 							" (stored at 0x" + std::to_string(symbolTableAddress) + ")";
 			} catch (const std::exception&) {
@@ -613,10 +631,10 @@ void Screen::executeInstruction(int coreId) {
 			break;
 		}
 		
-		// Access memory through memory manager using process name
+		// Access memory through memory manager using the process handle
 		if (globalMemoryManager) {
 			try {
-				uint16_t value = globalMemoryManager->readMemory(name_, address);
+				uint16_t value = globalMemoryManager->readMemory(memoryHandle_, address, coreId);
 				variables_[varName] = value;
 				logMessage = "READ: " + varName + " = " + std::to_string(value) + " from " + addrStr;
 			} catch (const std::exception&) {
@@ -649,10 +667,10 @@ void Screen::executeInstruction(int coreId) {
 			break;
 		}
 		
-		// Access memory through memory manager using process name
+		// Access memory through memory manager using the process handle
 		if (globalMemoryManager) {
 			try {
-				globalMemoryManager->writeMemory(name_, address, value);
+				globalMemoryManager->writeMemory(memoryHandle_, address, value, coreId);
 				logMessage = "WRITE: " + std::to_string(value) + " to " + addrStr;
 			} catch (const std::exception&) {
 				logMessage = "WRITE: Memory access violation at " + addrStr;
@@ -682,6 +700,80 @@ void Screen::executeInstruction(int coreId) {
 	currentBurst_++;
 }
 
+// Follows the same control flow as executeInstruction on a copy of the loop stack,
+// so loop bodies that will run again are prefetched instead of the code after them
+void Screen::prefetchUpcomingPages() {
+	std::vector<size_t> addresses;
+	std::stack<LoopContext> loops = loopStack_;
+	size_t pc = pc_;
+
+	for (int step = 0; step < PREFETCH_LOOKAHEAD && pc < instructions_.size(); step++) {
+		const Instruction& inst = instructions_[pc];
+
+		size_t address = 0;
+		if (memoryAddressOf(inst, address) &&
+			std::find(addresses.begin(), addresses.end(), address) == addresses.end()) {
+			addresses.push_back(address);
+		}
+
+		if (inst.type == Instruction::FOR && loops.size() < 3) {
+			LoopContext context;
+			context.iterations = parseValue(inst.args[0]);
+			context.currentIteration = 1;
+			context.startIndex = pc + 1;
+			context.depth = static_cast<int>(loops.size()) + 1;
+			loops.push(context);
+			pc = context.startIndex;
+		}
+		else if (inst.type == Instruction::ENDLOOP && !loops.empty()) {
+			LoopContext& context = loops.top();
+			context.currentIteration++;
+			if (context.currentIteration <= context.iterations) {
+				pc = context.startIndex;
+			}
+			else {
+				loops.pop();
+				pc++;
+			}
+		}
+		else {
+			pc++;
+		}
+	}
+
+	if (!addresses.empty()) {
+		globalMemoryManager->prefetchPages(memoryHandle_, addresses);
+	}
+}
+
+// Address an instruction will access: READ/WRITE use their operand, and
+// DECLARE/ADD/SUBTRACT update the symbol table at the start of memory
+bool Screen::memoryAddressOf(const Instruction& inst, size_t& address) {
+	switch (inst.type) {
+	case Instruction::DECLARE:
+	case Instruction::ADD:
+	case Instruction::SUBTRACT:
+		address = 0;
+		return true;
+	case Instruction::READ:
+	case Instruction::WRITE: {
+		std::string addrStr = trim(inst.type == Instruction::READ ? inst.args[1] : inst.args[0]);
+		try {
+			if (addrStr.substr(0, 2) == "0x" || addrStr.substr(0, 2) == "0X") {
+				address = static_cast<size_t>(std::stoul(addrStr, nullptr, 16));
+			} else {
+				address = static_cast<size_t>(std::stoul(addrStr));
+			}
+		} catch (const std::exception&) {
+			return false;
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
 uint16_t Screen::parseValue(const std::string& str) {
 	std::string s = trim(str);
 	if (std::all_of(s.begin(), s.end(), ::isdigit)) {
@@ -16,6 +16,9 @@
 #include <cctype>
 #include <random>
 #include <cstdint>
+#include <mutex>
+
+#include "ProcessHandle.h"
 
 class Screen {
 public:
@@ -50,6 +53,15 @@ public:
 
 	Screen(int id, const std::string& name, int totalBurst);
 
+	// Copy of this process (program, variables, program counter and loop stack)
+	// under a new id and name. Memory is attached separately by MemoryManager::forkProcess.
+	// The caller must hold pauseExecution() so the copy is taken between instructions.
+	std::shared_ptr<Screen> fork(int id, const std::string& name) const;
+
+	// executeInstruction holds this lock for the whole instruction, so holding it
+	// keeps a process that may be on a core paused between two instructions
+	std::unique_lock<std::mutex> pauseExecution() const { return std::unique_lock<std::mutex>(executionLock_.mutex); }
+
 	void draw() const;
 	void addLogEntry(int coreId, const std::string& message);
 	void exportLogs() const;
@@ -61,8 +73,10 @@ public:
 	void setVariableValue(const std::string& varName, uint16_t value);
 
 	// Memory management methods
-	void setMemorySize(int memorySize) { memorySize_ = memorySize; }
-	int getMemorySize() const { return memorySize_; }
+	void setMemorySize(size_t memorySize) { memorySize_ = memorySize; }
+	size_t getMemorySize() const { return memorySize_; }
+	void setMemoryHandle(ProcessHandle memoryHandle) { memoryHandle_ = memoryHandle; }
+	ProcessHandle getMemoryHandle() const { return memoryHandle_; }
 	void setMemoryValue(uint32_t address, uint16_t value) { memoryData_[address] = value; }
 	const std::map<uint32_t, uint16_t>& getMemoryData() const { return memoryData_; }
 	
@@ -110,7 +124,8 @@ private:
 	size_t pc_ = 0; // Program counter
 
 	// Memory management members
-	int memorySize_ = 0;
+	size_t memorySize_ = 0;
+	ProcessHandle memoryHandle_ = INVALID_PROCESS_HANDLE; // MemoryManager process handle, invalid until memory is allocated
 	std::map<uint32_t, uint16_t> memoryData_;
 	
 	// Memory access violation members
@@ -118,6 +133,15 @@ private:
 	std::string violationTimestamp_;
 	uint32_t violationAddress_ = 0;
 
+	// A fork copies everything else, but the child gets a lock of its own
+	struct ExecutionLock {
+		std::mutex mutex;
+		ExecutionLock() = default;
+		ExecutionLock(const ExecutionLock&) {}
+		ExecutionLock& operator=(const ExecutionLock&) { return *this; }
+	};
+	mutable ExecutionLock executionLock_;
+
 
 	std::string getCurrentTimeStamp();
 
@@ -125,6 +149,14 @@ private:
 
 	void generateInstructionsRecursive(int& instructionsGenerated, int depth, std::mt19937& gen);
 	Instruction generateRandomNonLoopInstruction(std::mt19937& gen);
+
+	// Instruction-driven prefetch: every PREFETCH_INTERVAL instructions, walk the next
+	// PREFETCH_LOOKAHEAD instructions (following loop back-edges) and ask the memory
+	// manager to load the pages they will touch
+	static const int PREFETCH_INTERVAL = 4;
+	static const int PREFETCH_LOOKAHEAD = 16;
+	void prefetchUpcomingPages();
+	bool memoryAddressOf(const Instruction& inst, size_t& address);
 };
 
 #endif // SCREEN_H
@@ -0,0 +1,18 @@
+#include "TLB.h"
+
+const TLBEntry* TLB::lookup(uint32_t processId, size_t virtualPage) const {
+    const TLBEntry& entry = entries[slotOf(processId, virtualPage)];
+    if (entry.frameTag != 0 && entry.processId == processId && entry.virtualPage == virtualPage) {
+        return &entry;
+    }
+    return nullptr;
+}
+
+void TLB::insert(uint32_t processId, size_t virtualPage, size_t frameNumber, uint64_t frameTag, bool writable) {
+    TLBEntry& entry = entries[slotOf(processId, virtualPage)];
+    entry.processId = processId;
+    entry.virtualPage = static_cast<uint32_t>(virtualPage);
+    entry.frameNumber = static_cast<uint32_t>(frameNumber);
+    entry.writable = writable;
+    entry.frameTag = frameTag;
+}
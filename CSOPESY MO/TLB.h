@@ -0,0 +1,48 @@
+#pragma once
+#ifndef TLB_H
+#define TLB_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Cached (process, virtual page) -> frame translation. frameTag is the load
+// sequence the frame had when the entry was filled; 0 marks an empty entry.
+// A page shared copy-on-write is cached read-only, so writes to it miss.
+struct TLBEntry {
+    uint32_t processId = 0;
+    uint32_t virtualPage = 0;
+    uint32_t frameNumber = 0;
+    bool writable = true;
+    uint64_t frameTag = 0;
+};
+
+// Small direct-mapped software TLB owned by one CPU core. Only the thread
+// running that core touches the entries, so they need no locking. Entries are
+// never shot down eagerly: evicting or freeing a frame changes its tag, and a
+// lookup whose tag no longer matches the frame is treated as a miss.
+class alignas(64) TLB {
+public:
+    static const size_t NUM_ENTRIES = 64;
+
+    // Entry caching the page, nullptr on a miss (the tag is checked by the caller)
+    const TLBEntry* lookup(uint32_t processId, size_t virtualPage) const;
+    void insert(uint32_t processId, size_t virtualPage, size_t frameNumber, uint64_t frameTag, bool writable = true);
+
+    // Single writer per counter, so a relaxed load/store pair is enough
+    void recordHit() { hits.store(hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    void recordMiss() { misses.store(misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    size_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    size_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+
+private:
+    static size_t slotOf(uint32_t processId, size_t virtualPage) {
+        return (virtualPage ^ (static_cast<size_t>(processId) * 0x9E3779B1u)) & (NUM_ENTRIES - 1);
+    }
+
+    std::array<TLBEntry, NUM_ENTRIES> entries;
+    std::atomic<size_t> hits{ 0 };
+    std::atomic<size_t> misses{ 0 };
+};
+
+#endif // TLB_H
@@ -51,9 +51,23 @@ int delaysPerExec = 0;
 
 // Memory configuration
 int maxOverallMemory = 0;
+int maxSwapMemory = 0;
 int memoryPerFrame = 0;
 int minMemoryPerProcess = 0;
 int maxMemoryPerProcess = 0;
+std::string pageReplacementPolicy = "fifo";
+std::string admissionPolicy = "fifo";
+std::string memoryAccessModel = "stress";
+int writebackQueueSize = 0;
+int reclaimLowWatermark = 0;
+int reclaimHighWatermark = 0;
+int maxReadaheadPages = 0;
+int prefetchBudget = 0;
+int dedupPagesPerScan = 0;
+int compressedSwapSize = 0;
+int workingSetWindow = 0;
+bool processSwapping = false;
+int hugePageSize = 0;
 
 // Mutexes
 std::mutex creationMutex;
@@ -53,9 +53,23 @@ extern int delaysPerExec;
 
 // Memory configuration
 extern int maxOverallMemory;
+extern int maxSwapMemory;
 extern int memoryPerFrame;
 extern int minMemoryPerProcess;
 extern int maxMemoryPerProcess;
+extern std::string pageReplacementPolicy;
+extern std::string admissionPolicy;
+extern std::string memoryAccessModel;
+extern int writebackQueueSize;
+extern int reclaimLowWatermark;
+extern int reclaimHighWatermark;
+extern int maxReadaheadPages;
+extern int prefetchBudget;
+extern int dedupPagesPerScan;
+extern int compressedSwapSize;
+extern int workingSetWindow;
+extern bool processSwapping;
+extern int hugePageSize;
 
 // Mutexes for thread safety
 extern std::mutex creationMutex;
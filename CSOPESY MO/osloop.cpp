@@ -99,14 +99,11 @@ void automaticProcessCreation() {
                 std::lock_guard<std::mutex> guard(creationMutex);
                 screen = std::make_shared<Screen>(nextId, name, totalBurst);
                 
-                // Allocate memory for the process
+                // Queue the process for memory; it stays WAITING until admitted
                 if (globalMemoryManager) {
                     int memorySize = minMemoryPerProcess + (rand() % (maxMemoryPerProcess - minMemoryPerProcess + 1));
-                    if (globalMemoryManager->allocateMemory(name, memorySize)) {
-                        screen->setMemorySize(memorySize);
-                        screen->setStatus("READY");
-                    } else {
-                        screen->setStatus("WAITING"); // Waiting for memory
+                    if (!globalMemoryManager->enqueueAdmission(screen, memorySize)) {
+                        screen->setStatus("WAITING"); // Can never fit in memory
                     }
                 } else {
                     screen->setStatus("READY");
@@ -116,9 +113,15 @@ void automaticProcessCreation() {
                 nextId++;
             }
 
-            // Schedule the process (no lock needed)
-            if (globalScheduler && screen->getStatus() == "READY") {
-                globalScheduler->addProcess(screen);
+            // Schedule the process (no lock needed), or whichever waiting processes fit now
+            if (globalScheduler) {
+                if (globalMemoryManager) {
+                    for (auto& admitted : globalMemoryManager->admitWaitingProcesses()) {
+                        globalScheduler->addProcess(admitted);
+                    }
+                } else if (screen->getStatus() == "READY") {
+                    globalScheduler->addProcess(screen);
+                }
             }
 
             createdCount++;
@@ -175,6 +178,35 @@ void enterScreen(std::shared_ptr<Screen> screen) {
     }
 }
 
+// Processes up to this size are committed in full; larger sizes reserve a sparse
+// address space whose pages are only backed once touched
+const size_t MAX_COMMITTED_PROCESS_MEMORY = 65536;
+
+// Parse and validate a memory size from the command line (power of 2, between 8
+// bytes and the largest sparse reservation). Prints the reason on failure.
+static bool parseMemorySize(const std::string& memorySize, size_t& memSize) {
+    try {
+        unsigned long long value = std::stoull(memorySize);
+        if (value < 8 || value > MemoryManager::MAX_RESERVATION_SIZE || (value & (value - 1)) != 0) {
+            std::cout << "Invalid memory allocation. Memory size must be a power of 2 between 8 and 65536 bytes, "
+                      << "or up to " << MemoryManager::MAX_RESERVATION_SIZE << " bytes to reserve a sparse address space.\n";
+            return false;
+        }
+        memSize = static_cast<size_t>(value);
+        return true;
+    } catch (const std::exception&) {
+        std::cout << "Invalid memory size format.\n";
+        return false;
+    }
+}
+
+static ProcessHandle allocateScreenMemory(const std::string& name, size_t memSize) {
+    if (memSize > MAX_COMMITTED_PROCESS_MEMORY) {
+        return globalMemoryManager->reserveAddressSpace(name, memSize);
+    }
+    return globalMemoryManager->allocateMemory(name, memSize);
+}
+
 void screenCommandWithInstructions(const std::string& name, const std::string& memorySize, const std::string& instructions) {
     if (name.empty()) {
         std::cout << "Process name cannot be empty.\n";
@@ -200,16 +232,8 @@ void screenCommandWithInstructions(const std::string& name, const std::string& m
         return;
     }
     
-    int memSize = 0;
-    try {
-        memSize = std::stoi(memorySize);
-        // Validate memory size (power of 2, between 8 and 65536)
-        if (memSize < 8 || memSize > 65536 || (memSize & (memSize - 1)) != 0) {
-            std::cout << "Invalid memory allocation. Memory size must be a power of 2 between 8 and 65536 bytes.\n";
-            return;
-        }
-    } catch (const std::exception&) {
-        std::cout << "Invalid memory size format.\n";
+    size_t memSize = 0;
+    if (!parseMemorySize(memorySize, memSize)) {
         return;
     }
     
@@ -240,8 +264,10 @@ void screenCommandWithInstructions(const std::string& name, const std::string& m
         
         // Allocate memory for the process
         if (globalMemoryManager) {
-            if (globalMemoryManager->allocateMemory(name, memSize)) {
+            ProcessHandle handle = allocateScreenMemory(name, memSize);
+            if (handle != INVALID_PROCESS_HANDLE) {
                 newScreen->setMemorySize(memSize);
+                newScreen->setMemoryHandle(handle);
                 newScreen->setStatus("READY");
                 std::cout << "Process '" << name << "' created with " << memSize << " bytes of memory and " 
                           << instructionList.size() << " custom instructions.\n";
@@ -269,21 +295,75 @@ void screenCommandWithInstructions(const std::string& name, const std::string& m
     }
 }
 
+// Clone a process and share its memory copy-on-write, so the child starts where
+// the parent is without regenerating its program or copying its pages
+void forkScreen(const std::string& parentName, const std::string& childName) {
+    std::shared_ptr<Screen> child = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(creationMutex);
+
+        std::shared_ptr<Screen> parent = nullptr;
+        for (const auto& screen : createdProcesses) {
+            if (screen->getName() == childName) {
+                std::cout << "Error: screen '" << childName << "' already exists.\n";
+                return;
+            }
+            if (screen->getName() == parentName) {
+                parent = screen;
+            }
+        }
+        if (!parent) {
+            std::cout << "Process " << parentName << " not found.\n";
+            return;
+        }
+        // Pause the parent between instructions, and keep it paused until its pages are
+        // shared, so the child's registers and memory are from the same moment
+        std::unique_lock<std::mutex> pausedParent = parent->pauseExecution();
+        if (parent->isFinished() || parent->getStatus() == "FINISHED" || parent->hasMemoryAccessViolation()) {
+            std::cout << "Process " << parentName << " is no longer running and cannot be forked.\n";
+            return;
+        }
+        if (globalMemoryManager && parent->getMemoryHandle() == INVALID_PROCESS_HANDLE) {
+            std::cout << "Process " << parentName << " is still waiting for memory and cannot be forked.\n";
+            return;
+        }
+
+        int nextId = createdProcesses.empty() ? 1 : (createdProcesses.back()->getId() + 1);
+        child = parent->fork(nextId, childName);
+
+        if (globalMemoryManager) {
+            ProcessHandle handle = globalMemoryManager->forkProcess(parent->getMemoryHandle(), childName);
+            if (handle == INVALID_PROCESS_HANDLE) {
+                std::cout << "Failed to fork process '" << parentName << "': not enough memory.\n";
+                return;
+            }
+            child->setMemorySize(parent->getMemorySize());
+            child->setMemoryHandle(handle);
+        }
+        child->setStatus("READY");
+        std::cout << "Process '" << childName << "' forked from '" << parentName << "'.\n";
+
+        createdProcesses.push_back(child);
+    }
+
+    if (globalScheduler) {
+        globalScheduler->addProcess(child);
+
+        if (!schedulerRunning) {
+            globalScheduler->start();
+            schedulerRunning = true;
+            std::cout << "Scheduler started\n";
+        }
+    }
+}
+
 void screenCommand(const std::string& dashOpt, const std::string& name, const std::string& memorySize) {
     if (dashOpt == "-s" && !name.empty()) {
-        int memSize = 0;
+        size_t memSize = 0;
         
         // Parse memory size if provided
         if (!memorySize.empty()) {
-            try {
-                memSize = std::stoi(memorySize);
-                // Validate memory size (power of 2, between 8 and 65536)
-                if (memSize < 8 || memSize > 65536 || (memSize & (memSize - 1)) != 0) {
-                    std::cout << "Invalid memory allocation. Memory size must be a power of 2 between 8 and 65536 bytes.\n";
-                    return;
-                }
-            } catch (const std::exception&) {
-                std::cout << "Invalid memory size format.\n";
+            if (!parseMemorySize(memorySize, memSize)) {
                 return;
             }
         } else {
@@ -315,8 +395,10 @@ void screenCommand(const std::string& dashOpt, const std::string& name, const st
             
             // Allocate memory for the process
             if (globalMemoryManager) {
-                if (globalMemoryManager->allocateMemory(name, memSize)) {
+                ProcessHandle handle = allocateScreenMemory(name, memSize);
+                if (handle != INVALID_PROCESS_HANDLE) {
                     newScreen->setMemorySize(memSize);
+                    newScreen->setMemoryHandle(handle);
                     newScreen->setStatus("READY");
                     std::cout << "Process '" << name << "' created with " << memSize << " bytes of memory.\n";
                 } else {
@@ -345,6 +427,10 @@ void screenCommand(const std::string& dashOpt, const std::string& name, const st
         // Enter the new screen
         //enterScreen(newScreen);
     }
+    else if (dashOpt == "-f" && !name.empty() && !memorySize.empty()) {
+        // screen -f <parent> <child>: the third argument is the child's name
+        forkScreen(name, memorySize);
+    }
     else if (dashOpt == "-r" && !name.empty()) {
         std::shared_ptr<Screen> targetScreen = nullptr;
 
@@ -386,6 +472,7 @@ void screenCommand(const std::string& dashOpt, const std::string& name, const st
         std::cout << "Usage:\n"
             << "  screen -s <name>   create screen\n"
             << "  screen -r <name>   redraw screen\n"
+            << "  screen -f <parent> <child>   fork a process copy-on-write\n"
             << "  screen -ls         list running/finished processes\n";
     }
 }
@@ -417,9 +504,23 @@ void bootstrap(const std::string& configFile) {
                 else if (key == "max-ins") maxInstructions = std::stoi(value);
                 else if (key == "delay-per-exec") delaysPerExec = std::stoi(value);
                 else if (key == "max-overall-mem") maxOverallMemory = std::stoi(value);
+                else if (key == "max-swap-mem") maxSwapMemory = std::stoi(value);
                 else if (key == "mem-per-frame") memoryPerFrame = std::stoi(value);
                 else if (key == "min-mem-per-proc") minMemoryPerProcess = std::stoi(value);
                 else if (key == "max-mem-per-proc") maxMemoryPerProcess = std::stoi(value);
+                else if (key == "page-replacement") pageReplacementPolicy = value;
+                else if (key == "admission-policy") admissionPolicy = value;
+                else if (key == "memory-access-model") memoryAccessModel = value;
+                else if (key == "writeback-queue-size") writebackQueueSize = std::stoi(value);
+                else if (key == "reclaim-low-watermark") reclaimLowWatermark = std::stoi(value);
+                else if (key == "reclaim-high-watermark") reclaimHighWatermark = std::stoi(value);
+                else if (key == "max-readahead-pages") maxReadaheadPages = std::stoi(value);
+                else if (key == "prefetch-budget") prefetchBudget = std::stoi(value);
+                else if (key == "dedup-pages-per-scan") dedupPagesPerScan = std::stoi(value);
+                else if (key == "compressed-swap-size") compressedSwapSize = std::stoi(value);
+                else if (key == "working-set-window") workingSetWindow = std::stoi(value);
+                else if (key == "process-swapping") processSwapping = (value == "true");
+                else if (key == "huge-page-size") hugePageSize = std::stoi(value);
                 else if (key == "is-evaluation-mode") {
                     if (value == "true") {
                         isEvaluationMode = true;
@@ -531,14 +632,65 @@ void OSLoop() {
 			std::cout << "  Maximum Instructions: " << maxInstructions << "\n";
             std::cout << "  Delays per Execution: " << delaysPerExec << "\n";
             std::cout << "  Max Overall Memory: " << maxOverallMemory << " bytes\n";
+            std::cout << "  Max Swap Memory: " << maxSwapMemory << " bytes\n";
             std::cout << "  Memory per Frame: " << memoryPerFrame << " bytes\n";
             std::cout << "  Min Memory per Process: " << minMemoryPerProcess << " bytes\n";
             std::cout << "  Max Memory per Process: " << maxMemoryPerProcess << " bytes\n";
+            std::cout << "  Page Replacement: " << pageReplacementPolicy << "\n";
+            std::cout << "  Admission Policy: " << admissionPolicy << "\n";
+            std::cout << "  Memory Access Model: " << memoryAccessModel << "\n";
+            std::cout << "  Write-back Queue Size: " << writebackQueueSize << " pages\n";
+            std::cout << "  Compressed Swap Size: " << compressedSwapSize << " bytes\n";
+            std::cout << "  Max Readahead: " << maxReadaheadPages << " pages\n";
+            std::cout << "  Prefetch Budget: " << prefetchBudget << " pages per process\n";
+            std::cout << "  Dedup Scan Rate: " << dedupPagesPerScan << " pages per pass\n";
+            std::cout << "  Working-Set Window: " << workingSetWindow << " instructions\n";
+            std::cout << "  Process Swapping: " << (processSwapping ? "true" : "false") << "\n";
+            std::cout << "  Huge Page Size: " << hugePageSize << " bytes\n";
+            std::cout << "  Reclaim Watermarks: " << reclaimLowWatermark << " / " << reclaimHighWatermark << " free frames\n";
             std::cout << "  Evaluation Mode: " << (isEvaluationMode ? "true" : "false") << "\n";
 
             // Initialize memory manager
             if (!globalMemoryManager) {
                 globalMemoryManager = std::make_unique<MemoryManager>(maxOverallMemory, memoryPerFrame);
+                if (!globalMemoryManager->setReplacementPolicy(pageReplacementPolicy)) {
+                    std::cout << "Unknown page replacement policy '" << pageReplacementPolicy << "', using FIFO\n";
+                }
+                if (!globalMemoryManager->setAdmissionPolicy(admissionPolicy)) {
+                    std::cout << "Unknown admission policy '" << admissionPolicy << "', using FIFO\n";
+                }
+                if (!globalMemoryManager->setAccessModel(memoryAccessModel)) {
+                    std::cout << "Unknown memory access model '" << memoryAccessModel << "', using stress\n";
+                }
+                if (writebackQueueSize > 0) {
+                    globalMemoryManager->setWritebackQueueSize(static_cast<size_t>(writebackQueueSize));
+                }
+                if (compressedSwapSize > 0) {
+                    globalMemoryManager->setCompressedPoolSize(static_cast<size_t>(compressedSwapSize));
+                }
+                if (maxReadaheadPages > 0) {
+                    globalMemoryManager->setMaxReadahead(static_cast<size_t>(maxReadaheadPages));
+                }
+                if (prefetchBudget > 0) {
+                    globalMemoryManager->setPrefetchBudget(static_cast<size_t>(prefetchBudget));
+                }
+                if (dedupPagesPerScan > 0) {
+                    globalMemoryManager->setDedupScanRate(static_cast<size_t>(dedupPagesPerScan));
+                }
+                if (workingSetWindow > 0) {
+                    globalMemoryManager->setWorkingSetWindow(static_cast<size_t>(workingSetWindow));
+                }
+                globalMemoryManager->setProcessSwapping(processSwapping);
+                if (hugePageSize > 0 && !globalMemoryManager->setHugePageSize(static_cast<size_t>(hugePageSize))) {
+                    std::cout << "Invalid huge page size " << hugePageSize << ", huge pages disabled\n";
+                }
+                if (reclaimLowWatermark > 0) {
+                    globalMemoryManager->setReclaimWatermarks(static_cast<size_t>(reclaimLowWatermark),
+                                                              static_cast<size_t>(reclaimHighWatermark));
+                }
+                if (maxSwapMemory > 0) {
+                    globalMemoryManager->setSwapCapacity(static_cast<size_t>(maxSwapMemory));
+                }
                 std::cout << "Memory manager initialized\n";
             }
 
@@ -614,16 +766,90 @@ void OSLoop() {
                 std::cout << "Total Memory: " << stats.totalMemory << " bytes\n";
                 std::cout << "Used Memory: " << stats.usedMemory << " bytes\n";
                 std::cout << "Free Memory: " << stats.freeMemory << " bytes\n";
+                std::cout << "Swap Space: " << stats.swapMemory << " bytes\n";
+                std::cout << "Admission Queue: " << stats.admissionQueueLength << " waiting\n";
+                std::cout << "Avg Admission Latency: " << std::fixed << std::setprecision(2)
+                          << stats.avgAdmissionLatencyMs << " ms\n";
                 std::cout << "Idle CPU Ticks: " << stats.idleCpuTicks << "\n";
                 std::cout << "Active CPU Ticks: " << stats.activeCpuTicks << "\n";
                 std::cout << "Total CPU Ticks: " << stats.totalCpuTicks << "\n";
                 std::cout << "Num Paged In: " << stats.numPagedIn << "\n";
                 std::cout << "Num Paged Out: " << stats.numPagedOut << "\n";
+                std::cout << "Dirty Evictions: " << stats.numDirtyEvictions << "\n";
+                std::cout << "Clean Evictions: " << stats.numCleanEvictions << "\n";
+                std::cout << "Zero-Page Reads: " << stats.zeroPageReads << "\n";
+                std::cout << "Zero-Fill Faults: " << stats.zeroFillFaults << "\n";
+                std::cout << "COW Forks: " << stats.cowForks << "\n";
+                std::cout << "COW Copies: " << stats.cowCopies << "\n";
+                std::cout << "Shared Frames: " << stats.sharedFrames << "\n";
+                std::cout << "Dedup Scanned Pages: " << stats.dedupScannedPages << "\n";
+                std::cout << "Local Replacements: " << stats.localReplacements << "\n";
+                std::cout << "Processes Held Back: " << stats.heldBackProcesses << "\n";
+                std::cout << "Process Swap-outs: " << stats.processSwapOuts << " (" << stats.bulkPagesOut << " pages)\n";
+                std::cout << "Process Swap-ins: " << stats.processSwapIns << " (" << stats.bulkPagesIn << " pages)\n";
+                std::cout << "Huge Pages: " << stats.hugePromotions << " promoted, " << stats.hugeDemotions << " demoted\n";
+                std::cout << "Huge Page Faults: " << stats.hugePageFaults << "\n";
+                std::cout << "Huge Page Evictions: " << stats.hugePageEvictions << "\n";
+                std::cout << "Write-back Queue: " << stats.writebackQueueDepth << " pages\n";
+                std::cout << "Write-back Lag: " << std::fixed << std::setprecision(2)
+                          << stats.writebackLagMs << " ms\n";
+                std::cout << "Page-ins From Write-back Queue: " << stats.writebackQueueReads << "\n";
+                std::cout << "Compressed Pool: " << stats.compressedPoolPages << " pages in "
+                          << stats.compressedPoolBytes << " bytes\n";
+                std::cout << "Compression Ratio: " << std::fixed << std::setprecision(2)
+                          << stats.compressionRatio << "\n";
+                std::cout << "Compressed Pool Hit Rate: " << std::fixed << std::setprecision(2)
+                          << (stats.compressedPoolHits + stats.compressedPoolMisses > 0
+                              ? 100.0 * stats.compressedPoolHits / (stats.compressedPoolHits + stats.compressedPoolMisses) : 0.0)
+                          << "%\n";
+                std::cout << "Compressed Pool Spills: " << stats.compressedPoolSpills << "\n";
+                std::cout << "Incompressible Pages: " << stats.compressedPoolRejects << "\n";
+                std::cout << "Reclaimer Wakeups: " << stats.reclaimWakeups << "\n";
+                std::cout << "Reclaimed Pages: " << stats.reclaimedPages << "\n";
+                std::cout << "Avg Reclaim Batch: " << std::fixed << std::setprecision(2)
+                          << (stats.reclaimWakeups > 0 ? static_cast<double>(stats.reclaimedPages) / stats.reclaimWakeups : 0.0)
+                          << " pages\n";
+                std::cout << "Reclaim Time: " << std::fixed << std::setprecision(2) << stats.reclaimTimeMs << " ms\n";
+                std::cout << "Direct Reclaims: " << stats.directReclaims << "\n";
+                std::cout << "Readahead Pages: " << stats.readaheadPages << "\n";
+                std::cout << "Readahead Hits: " << stats.readaheadHits << "\n";
+                std::cout << "Readahead Waste: " << stats.readaheadWaste << "\n";
+                std::cout << "Prefetch Requests: " << stats.prefetchRequests << " (" << stats.prefetchDropped << " over budget)\n";
+                std::cout << "Prefetched Pages: " << stats.prefetchedPages << "\n";
+                std::cout << "Prefetch Hits: " << stats.prefetchHits << "\n";
+                std::cout << "Prefetch Waste: " << stats.prefetchWaste << "\n";
+                // Accuracy: prefetched pages that were used. Coverage: share of page
+                // misses that prefetching absorbed instead of a fault.
+                std::cout << "Prefetch Accuracy: " << std::fixed << std::setprecision(0)
+                          << (stats.prefetchedPages > 0 ? 100.0 * stats.prefetchHits / stats.prefetchedPages : 0.0) << "%\n";
+                std::cout << "Prefetch Coverage: " << std::fixed << std::setprecision(0)
+                          << (stats.prefetchHits + stats.numPageFaults > 0
+                              ? 100.0 * stats.prefetchHits / (stats.prefetchHits + stats.numPageFaults) : 0.0) << "%\n";
+                std::cout << "TLB Hits: " << stats.tlbHits << "\n";
+                std::cout << "TLB Misses: " << stats.tlbMisses << "\n";
+                std::cout << "Page Replacement: " << stats.replacementPolicy << "\n";
+                std::cout << "Access Model: " << stats.accessModel << "\n";
                 std::cout << "=========================================================================\n";
             } else {
                 std::cout << "Memory manager not initialized. Run 'initialize' first.\n";
             }
         }
+        else if (command == "membench") {
+            // Usage: membench [max-cores]
+            int maxCores = 64;
+            if (!dashOpt.empty()) {
+                try {
+                    maxCores = std::stoi(dashOpt);
+                } catch (const std::exception&) {
+                    maxCores = 0;
+                }
+            }
+            if (maxCores < 1) {
+                std::cout << "Invalid core count. Use: membench [max-cores]\n";
+            } else {
+                runMemoryBenchmark(maxCores);
+            }
+        }
         else if (command == "report-util") {
             exportSchedulerReport();
         }
@@ -20,6 +20,7 @@
 #include "Scheduler.h"     
 #include "FCFSScheduler.h" 
 #include "RRScheduler.h"
+#include "MemoryBenchmark.h"
 #include "globals.h"   
 
 #ifdef _WIN32
@@ -38,6 +39,7 @@ void printHeader();
 void nvidiasmi(const std::map<int, Process>& processes);
 void screenCommand(const std::string& dashOpt, const std::string& name, const std::string& memorySize = "");
 void screenCommandWithInstructions(const std::string& name, const std::string& memorySize, const std::string& instructions);
+void forkScreen(const std::string& parentName, const std::string& childName);
 void bootstrap(const std::string& configFile = "config.txt");
 void enterScreen(std::shared_ptr<Screen> screen);
 void OSLoop();